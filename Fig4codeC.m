@@ -35,6 +35,14 @@ classdef Fig4codeC < handle
     % Repeating the above command does not make the object to recompute the value. Instead
     % the object returns the value computed before, which is stored internally by the object.
     %
+    % By default, the losses are computed as in the publication. Setting
+    %
+    %   fig4.engine = 'pops';
+    %
+    % computes all of them at once with dinidlGaussPops instead, which approximates the
+    % distributions of the log-likelihood ratios on a grid and therefore differs slightly
+    % from the published values.
+    %
     % REMARKS
     %
     % This code is analogous to Fig4code, but with the functions computing
@@ -55,11 +63,13 @@ classdef Fig4codeC < handle
     %
     % - infoGauss.c
     % - dinidlGaussTheta.c
+    % - dinidlGaussPops.c (only for engine 'pops')
     %
     % These files can be compiled as follows
     %
     %   mex -v GCC='/usr/bin/gcc-4.7' -lm infoGauss.c
     %   mex -v GCC='/usr/bin/gcc-4.7' -lgsl -lgslcblas -lm dinidlGaussTheta.c
+    %   mex -v GCC='/usr/bin/gcc-4.7' CFLAGS='$CFLAGS -fopenmp' LDFLAGS='$LDFLAGS -fopenmp' -lgsl -lgslcblas -lm dinidlGaussPops.c
     %
     % where you should replace /usr/bin/gcc-4.7 for the appropriate folder
     % and C compiler compatible with your Matlab installation.
@@ -67,6 +77,8 @@ classdef Fig4codeC < handle
     % VERSION CONTROL
     %
     % V1.000 Hugo Gabriel Eyherabide (10 Feb 2017)
+    % V1.001 All losses computed together by dinidlGaussPops (18 Oct 2026)
+    % V1.002 dinidlGaussPops used only if selected with engine (19 Oct 2026)
     %
     % Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
     %
@@ -105,6 +117,8 @@ classdef Fig4codeC < handle
         q
         % Values of rho
         rho
+        % Engine computing the losses: 'theta' (default, as published) or 'pops'
+        engine = 'theta'
     end
     
     properties(Dependent)
@@ -139,6 +153,7 @@ classdef Fig4codeC < handle
             this.di1p2_p = [];
             this.di12_p  = [];
             this.info_p  = [];
+            this.dint12_p = [];
         end
         
         function set.q(this,val)
@@ -158,6 +173,16 @@ classdef Fig4codeC < handle
             this.di12_p  = [];
             this.di1p2_p = [];
             this.info_p  = [];
+            this.dint12_p = [];
+        end
+        
+        function set.engine(this,val)
+            if any(strcmp(val,{'theta','pops'}))
+                this.engine = val;
+                this.reset;
+            else
+                error('The engine must be ''theta'' or ''pops''');
+            end
         end
         
         function set.rho(this,val)
@@ -173,8 +198,12 @@ classdef Fig4codeC < handle
         
         function val = get.di12(this)
             if isempty(this.di12_p)
-                if isempty(this.q) || isempty(this.rho), error('Please specify "q" and "rho"'); end
-                this.di12_p = dinidlGaussTheta([this.q,this.rho,this.rho]);
+                if strcmp(this.engine,'pops')
+                    this.losses;
+                else
+                    if isempty(this.q) || isempty(this.rho), error('Please specify "q" and "rho"'); end
+                    this.di12_p = dinidlGaussTheta([this.q,this.rho,this.rho]);
+                end
             end
             val = this.di12_p;
         end
@@ -189,27 +218,67 @@ classdef Fig4codeC < handle
         
         function val = get.di1(this)
             if isempty(this.di1_p)
-                if isempty(this.q) || isempty(this.rho), error('Please specify "q" and "rho"'); end
-                this.di1_p = 0;
+                if strcmp(this.engine,'pops')
+                    this.losses;
+                else
+                    if isempty(this.q) || isempty(this.rho), error('Please specify "q" and "rho"'); end
+                    this.di1_p = 0;
+                end
             end
             val = this.di1_p;
         end
         
         function val = get.di2(this)
             if isempty(this.di2_p)
-                if isempty(this.q) || isempty(this.rho), error('Please specify "q" and "rho"'); end
-                this.di2_p = 0;
+                if strcmp(this.engine,'pops')
+                    this.losses;
+                else
+                    if isempty(this.q) || isempty(this.rho), error('Please specify "q" and "rho"'); end
+                    this.di2_p = 0;
+                end
             end
             val = this.di2_p;
         end
         
         function val = get.di1p2(this)
             if isempty(this.di1p2_p)
-                if isempty(this.q) || isempty(this.rho), error('Please specify "q" and "rho"'); end
-                this.di1p2_p = 0;
+                if strcmp(this.engine,'pops')
+                    this.losses;
+                else
+                    if isempty(this.q) || isempty(this.rho), error('Please specify "q" and "rho"'); end
+                    this.di1p2_p = 0;
+                end
             end
             val = this.di1p2_p;
         end
         
+        function val = get.dint12(this)
+            if isempty(this.dint12_p)
+                if strcmp(this.engine,'pops')
+                    this.losses;
+                else
+                    this.dint12_p = this.di12-this.di1p2;
+                end
+            end
+            val = this.dint12_p;
+        end
+        
+    end
+    
+    methods(Access = private)
+        function losses(this)
+            % Computes all communication information losses at once, sharing the
+            % distributions of the log-likelihood ratios of each population
+            if isempty(this.q) || isempty(this.rho), error('Please specify "q" and "rho"'); end
+            pops = struct('q',{this.q,1-this.q},'mu1',{[-1,-1],-1},'mu2',{[1,1],1},...
+                'C1',{[1,this.rho;this.rho,1],1},'C2',{[1,this.rho;this.rho,1],1});
+            res = dinidlGaussPops(pops);
+            this.di1_p    = res.di(1);
+            this.di2_p    = res.di(2);
+            this.di1p2_p  = res.di1p2;
+            this.di12_p   = res.di12;
+            this.dint12_p = res.dint12;
+        end
+        
     end
 end
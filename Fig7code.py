@@ -20,6 +20,7 @@
 # - json
 # - math 
 # - numpy
+# - concurrent.futures and collections (nested quadrature only)
 #
 # ARGUMENTS AND VARIABLES:
 #
@@ -47,9 +48,47 @@
 # res7b = F7c.resultsFig7b	
 # res7c = F7c.resultsFig7c	
 #
+# Each of these functions accepts the optional arguments progress and cancel. The
+# function progress is called after each point of the sweep with a dict reporting the
+# points completed, the elapsed and remaining time, and the error estimates (see
+# sweepRunner.py). The sweep stops before the next point once cancel (e.g., a
+# threading.Event) is set, and the points finished so far are returned. With the optional
+# argument table (a ResultTable of sweepRunner.py), processes running these functions at
+# the same time share their results, so that each point is computed only once.
+#
+# The vegas integrators of Figures 7b and 7c are trained for 10 iterations before computing
+# each integral. With the optional argument maps (a MapStore), the trained maps are stored
+# in a folder, and later runs start from the stored map with the nearest limits of
+# integration, rescaled to the new limits, training for 2 iterations only. For example,
+#
+# res7b = F7c.resultsFig7b(maps=F7c.MapStore('maps'))
+#
+# With the optional argument method='nested', the integrals of Figures 7b and 7c are
+# computed deterministically instead (see NestedQuadrature): an adaptive cubature over x and y
+# nested inside Gauss-Legendre rules over q, rho1 and rho2. The results are free of noise,
+# so that the communication loss is minimized over a smooth function of theta, and their
+# standard deviations are replaced by error estimates. For example,
+#
+# res7c = F7c.resultsFig7c(method='nested')
+#
+# With the optional argument target, the vegas integrals are sampled sequentially, with the
+# maps fixed after training, until their standard deviations are at most target (see
+# SampleController). target may also be a dict with the keys 'dinid', 'dinidl', 'info' and
+# 'diff', the latter for the difference between the communication and the descriptive
+# losses, computed from the same samples. Omitted keys impose no target. The results then
+# include the fields diffmv and diffsd of the difference, and the number of samples neval
+# drawn for each point after training. For example,
+#
+# res7b = F7c.resultsFig7b(target={'dinid':1E-4,'dinidl':1E-4,'info':1E-3,'diff':2E-5})
+#
 # VERSION CONTROL
 # 
 # V1.000 Hugo Gabriel Eyherabide (10 Feb 2017)
+# V1.001 Progress reports and cancellation of the sweeps (19 Oct 2026)
+# V1.002 Results shared among processes (19 Oct 2026)
+# V1.003 Trained vegas maps stored for later runs (19 Oct 2026)
+# V1.004 Deterministic nested quadrature for Figures 7b and 7c (19 Oct 2026)
+# V1.005 Samples allocated to reach target standard deviations (19 Oct 2026)
 # 
 # Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
 #
@@ -89,7 +128,12 @@ from scipy.integrate import dblquad, quad
 import vegas
 import math as m
 import json
+import collections
+import concurrent.futures
 import numpy
+import os
+import pickle
+from sweepRunner import SweepProgress
 
 # Integrand for computing communication information loss in Figure 7a
 def dinidlintFig7a(q,a,theta):
@@ -115,9 +159,20 @@ def infoFig7a():
 
 
 
+# Keeps the first num points of the results of a cancelled sweep
+def truncateResults(data,num):
+    return {key:val[:num] for key,val in data.items()}
+
+# Results of the point key of a sweep, computed by compute() or, if table is given, taken
+# from the results shared by other processes
+def sharedPoint(table,domain,key,compute):
+    if table is None:
+        return compute()
+    return table.compute(domain,key,compute)
+
 # Compute the descriptive and communication losses for large number of independent
 # information streams in Figure 7a
-def resultsFig7a():
+def resultsFig7a(progress=None,cancel=None,table=None):
 
     # amax denotes the maximum value of the interval from which the probability
     # of the response [2,2] given that the stimulus was a box is chosen for each
@@ -135,7 +190,10 @@ def resultsFig7a():
     data['infomv'][0] = aux[0]/0.9
     data['infosd'][0] = aux[1]/0.9
 
+    tracker = SweepProgress(alen)
     for ind in range(0,alen):
+        if cancel is not None and cancel.is_set():
+            return truncateResults(data,ind)
         amaxnow = amax[ind]
         data['amax'][ind] = amaxnow  
         data['infomv'][ind] = data['infomv'][0]
@@ -143,22 +201,115 @@ def resultsFig7a():
         
         probArea = 0.9*(amaxnow-0.05)
         
-        # Computes the descriptive information loss
-        aux = dinidFig7a(amaxnow)
+        # Computes the descriptive and the communication information loss
+        aux = sharedPoint(table,'Fig7a dblquad 1e-6 1e-3',[amaxnow],
+                          lambda: list(dinidFig7a(amaxnow))+list(dinidlFig7a(amaxnow)))
         data['dipmv'][ind] = aux[0]/probArea
         data['dipsd'][ind] = aux[1]/probArea
-
-        # Computes the communication information loss
-        aux = dinidlFig7a(amaxnow)
-        data['dilmv'][ind] = aux[0]/probArea
-        data['dilsd'][ind] = aux[1]/probArea
+        data['dilmv'][ind] = aux[2]/probArea
+        data['dilsd'][ind] = aux[3]/probArea
         
         print([amax,data['dipmv'][ind],data['dilmv'][ind],data['infomv'][ind]])
+        tracker.done(ind,max(data['dipsd'][ind],data['dilsd'][ind]))
+        if progress is not None:
+            progress(tracker.report())
     
     return data
 
 
 
+# Trained vegas maps stored in the folder path, one file per integral (e.g., 'dinidlFig7b'),
+# each with the grids of the maps trained for different limits of integration. The stored
+# map with the nearest limits, if none differs by more than radius, is rescaled to the
+# requested limits.
+class MapStore:
+
+    def __init__(self,path,radius=0.1):
+        self.path = path
+        self.radius = radius
+        os.makedirs(path,exist_ok=True)
+
+    def _read(self,name):
+        try:
+            with open(os.path.join(self.path,name+'.pkl'),'rb') as infile:
+                return pickle.load(infile)
+        except (OSError,EOFError,pickle.UnpicklingError):
+            return []
+
+    # Map for the integral name and the limits, or None if there is none close enough
+    def get(self,name,limits):
+        limits = numpy.asarray(limits,dtype=float)
+        best, dist = None, self.radius
+        for entry in self._read(name):
+            if entry['limits'].shape!=limits.shape:
+                continue
+            now = numpy.max(numpy.abs(entry['limits']-limits))
+            if now<=dist:
+                best, dist = entry, now
+        if best is None:
+            return None
+        grid = [lim[0]+(nodes-old[0])*(lim[1]-lim[0])/(old[1]-old[0])
+                for nodes,old,lim in zip(best['grid'],best['limits'],limits)]
+        return vegas.AdaptiveMap(grid)
+
+    # Stores the map of a trained integrator, replacing the one with the same limits. The
+    # file is replaced at once, so that other processes never read a partial file.
+    def put(self,name,limits,amap):
+        limits = numpy.asarray(limits,dtype=float)
+        ninc = numpy.broadcast_to(numpy.asarray(amap.ninc),(amap.dim,))
+        grid = [numpy.array(amap.grid[d,:ninc[d]+1]) for d in range(amap.dim)]
+        entries = [entry for entry in self._read(name)
+                   if entry['limits'].shape!=limits.shape or numpy.any(entry['limits']!=limits)]
+        entries.append({'limits':limits,'grid':grid})
+        tmp = os.path.join(self.path,'%s.%d.tmp' % (name,os.getpid()))
+        with open(tmp,'wb') as outfile:
+            pickle.dump(entries,outfile)
+        os.replace(tmp,os.path.join(self.path,name+'.pkl'))
+
+# Vegas integrator for the limits, trained on the integrand f for 10 iterations, or for 2
+# iterations if maps has a map for the integral name close to the limits
+def trainedIntegrator(name,limits,f,samplesize,maps=None):
+    start = maps.get(name,limits) if maps is not None else None
+    integ = vegas.Integrator(start if start is not None else limits)
+    integ(f, nitn=10 if start is None else 2,neval=samplesize)
+    return integ
+
+# Stores the map of a trained integrator, if maps is given
+def storeIntegrator(name,limits,integ,maps=None):
+    if maps is not None:
+        maps.put(name,limits,integ.map)
+
+# Sequential sampling of trained vegas integrators for integrands whose values are lists.
+# Iterations of samplesize samples, with the map fixed, are averaged with equal weights until
+# the standard deviation of each value is at most its target, or until maxitn iterations.
+# After miniter iterations, the iterations still needed are predicted from the largest ratio
+# between the variances and their targets, so that a few rounds usually suffice. neval
+# counts the samples drawn by run, excluding those used for training and minimization.
+class SampleController:
+
+    def __init__(self,samplesize=100000,miniter=2,maxitn=200):
+        self.samplesize = samplesize
+        self.miniter = miniter
+        self.maxitn = maxitn
+        self.neval = 0
+
+    def run(self,integ,f,targets):
+        targets = numpy.asarray(targets,dtype=float)
+        means, variances = [], []
+        nitn = self.miniter
+        while nitn>0:
+            for itn in range(0,nitn):
+                res = integ(f,nitn=1,neval=self.samplesize,adapt=False)
+                means.append([val.mean for val in res])
+                variances.append([val.sdev**2 for val in res])
+            num = len(means)
+            sdev = numpy.sqrt(numpy.sum(variances,axis=0))/num
+            ratio = numpy.max((sdev/targets)**2)
+            nitn = min(self.maxitn-num,int(m.ceil(num*ratio))-num) if ratio>1 else 0
+            nitn = max(nitn,1) if ratio>1 and num<self.maxitn else nitn
+        self.neval += num*self.samplesize
+        return [QuadResult(float(mean),float(sd)) for mean,sd in zip(numpy.mean(means,axis=0),sdev)]
+
 # Integrand for computing the descriptive and the communication information loss in Figure 7b
 # Recall that the former is equal to the latter with theta=1, and that in Figure 7b, the
 # correlation coefficients of the responses associated with boxes and circles are the same
@@ -172,39 +323,45 @@ def infointFig7b(data):
     return infointFig7c(data)
 
 # Descriptive information loss in Figure 7b
-def dinidFig7b(samplesize,amax,rhomax,opt={'xtol':1E-4}):
-    # The integration is performed 10 times in order to train the integrator
-    # and then 10 times more in order to compute the actual values.
+def dinidFig7b(samplesize,amax,rhomax,opt={'xtol':1E-4},maps=None):
+    # The integration is performed 10 times (or 2 with a stored map) in order to train the
+    # integrator and then 10 times more in order to compute the actual values.
     # Check the documentaion of vegas for more information.
-    integ = vegas.Integrator([[-5,5],[-5,5],[0.05,amax],[-.95,rhomax]])
-    integ(lambda data: dinidlintFig7b(data,1), nitn=10,neval=samplesize)
-    return integ(lambda data: dinidlintFig7b(data,1), nitn=10,neval=samplesize)
+    limits = [[-5,5],[-5,5],[0.05,amax],[-.95,rhomax]]
+    integ = trainedIntegrator('dinidFig7b',limits,lambda data: dinidlintFig7b(data,1),samplesize,maps)
+    res = integ(lambda data: dinidlintFig7b(data,1), nitn=10,neval=samplesize)
+    storeIntegrator('dinidFig7b',limits,integ,maps)
+    return res
 
     
 # Communication information loss in Figure 7b
-def dinidlFig7b(samplesize,amax,rhomax,opt={'xtol':1E-4}):
-    # The integration is performed 10 times in order to train the integrator
-    # and then 10 times more in order to compute the actual values.
+def dinidlFig7b(samplesize,amax,rhomax,opt={'xtol':1E-4},maps=None):
+    # The integration is performed 10 times (or 2 with a stored map) in order to train the
+    # integrator and then 10 times more in order to compute the actual values.
     # Check the documentaion of vegas for more information.
-    integ = vegas.Integrator([[-5,5],[-5,5],[0.05,amax],[-.95,rhomax]])
-    integ(lambda data: dinidlintFig7b(data,1), nitn=10,neval=samplesize)
+    limits = [[-5,5],[-5,5],[0.05,amax],[-.95,rhomax]]
+    integ = trainedIntegrator('dinidlFig7b',limits,lambda data: dinidlintFig7b(data,1),samplesize,maps)
     theta = minimize(lambda theta: integ(lambda data: dinidlintFig7b(data,theta), nitn=10,neval=samplesize).mean,method='brent',options=opt)
-    return integ(lambda data: dinidlintFig7b(data,theta.x), nitn=10,neval=samplesize)
+    res = integ(lambda data: dinidlintFig7b(data,theta.x), nitn=10,neval=samplesize)
+    storeIntegrator('dinidlFig7b',limits,integ,maps)
+    return res
     
 
 # Total transmitted information in Figure 7b
-def infoFig7b(samplesize,amax,rhomax,opt={'xtol':1E-4}):
-    # The integration is performed 10 times in order to train the integrator
-    # and then 10 times more in order to compute the actual values.
+def infoFig7b(samplesize,amax,rhomax,opt={'xtol':1E-4},maps=None):
+    # The integration is performed 10 times (or 2 with a stored map) in order to train the
+    # integrator and then 10 times more in order to compute the actual values.
     # Check the documentaion of vegas for more information.
-    integ = vegas.Integrator([[-5,5],[-5,5],[0.05,amax],[-.95,rhomax]])
-    integ(infointFig7b, nitn=10,neval=samplesize)
-    return integ(infointFig7b, nitn=10,neval=samplesize)
+    limits = [[-5,5],[-5,5],[0.05,amax],[-.95,rhomax]]
+    integ = trainedIntegrator('infoFig7b',limits,infointFig7b,samplesize,maps)
+    res = integ(infointFig7b, nitn=10,neval=samplesize)
+    storeIntegrator('infoFig7b',limits,integ,maps)
+    return res
 
 
 # Compute the descriptive and communication losses for large number of independent
 # information streams in Figure 7b
-def resultsFig7b():
+def resultsFig7b(progress=None,cancel=None,table=None,maps=None,method='vegas',target=None):
 
     # rhomax denotes the maximum value of the interval from which the correlation coefficients
     # are chosen for each independent information stream
@@ -215,28 +372,25 @@ def resultsFig7b():
     datazero = lambda: [0 for ind in range(0,rholen)];
     data = {'rhomax': datazero(),'dipmv':datazero(),'dipsd':datazero(),
             'dilmv':datazero(),'dilsd':datazero(),'infomv':datazero(),'infosd':datazero()}   
+    if target is not None and method!='nested':
+        data.update({'diffmv':datazero(),'diffsd':datazero(),'neval':datazero()})
 
-
+    tracker = SweepProgress(rholen)
     for ind in range(0,rholen):
+        if cancel is not None and cancel.is_set():
+            return truncateResults(data,ind)
         rhomaxnow = rhomax[ind]
         data['rhomax'][ind] = rhomaxnow  
                 
-        # Computes the descriptive information loss
-        aux = dinidFig7b(100000,0.95,rhomaxnow)
-        data['dipmv'][ind] = aux.mean
-        data['dipsd'][ind] = aux.sdev
-
-        # Computes the communication information loss
-        aux = dinidlFig7b(100000,0.95,rhomaxnow)
-        data['dilmv'][ind] = aux.mean
-        data['dilsd'][ind] = aux.sdev
-                   
-        # Computes the transmitted information
-        aux = infoFig7b(100000,0.95,rhomaxnow)
-        data['infomv'][ind] = aux.mean
-        data['infosd'][ind] = aux.sdev
+        # Computes the descriptive and the communication information loss, and the
+        # transmitted information
+        aux = pointFig7('7b',rhomaxnow,method,target,maps,table)
+        storeFig7(data,ind,aux)
         
         print([rhomaxnow,data['dipmv'][ind],data['dilmv'][ind],data['infomv'][ind]])
+        tracker.done(ind,max(data['dipsd'][ind],data['dilsd'][ind],data['infosd'][ind]))
+        if progress is not None:
+            progress(tracker.report())
   
 
     return data
@@ -298,39 +452,242 @@ def infointFig7c(data):
 
 
 # Descriptive information loss in Figure 7c
-def dinidFig7c(samplesize,amax,rhomax,opt={'xtol':1E-4}):
-    # The integration is performed 10 times in order to train the integrator
-    # and then 10 times more in order to compute the actual values.
+def dinidFig7c(samplesize,amax,rhomax,opt={'xtol':1E-4},maps=None):
+    # The integration is performed 10 times (or 2 with a stored map) in order to train the
+    # integrator and then 10 times more in order to compute the actual values.
     # Check the documentaion of vegas for more information.
-    integ = vegas.Integrator([[-5,5],[-5,5],[0.05,amax],[-.95,rhomax],[-.95,rhomax]])
-    integ(lambda data: dinidlintFig7c(data,1), nitn=10,neval=samplesize)
-    return integ(lambda data: dinidlintFig7c(data,1), nitn=10,neval=samplesize)
+    limits = [[-5,5],[-5,5],[0.05,amax],[-.95,rhomax],[-.95,rhomax]]
+    integ = trainedIntegrator('dinidFig7c',limits,lambda data: dinidlintFig7c(data,1),samplesize,maps)
+    res = integ(lambda data: dinidlintFig7c(data,1), nitn=10,neval=samplesize)
+    storeIntegrator('dinidFig7c',limits,integ,maps)
+    return res
 
     
 # Communication information loss in Figure 7c
-def dinidlFig7c(samplesize,amax,rhomax,opt={'xtol':1E-4}):
-    # The integration is performed 10 times in order to train the integrator
-    # and then 10 times more in order to compute the actual values.
+def dinidlFig7c(samplesize,amax,rhomax,opt={'xtol':1E-4},maps=None):
+    # The integration is performed 10 times (or 2 with a stored map) in order to train the
+    # integrator and then 10 times more in order to compute the actual values.
     # Check the documentaion of vegas for more information.
-    integ = vegas.Integrator([[-5,5],[-5,5],[0.05,amax],[-.95,rhomax],[-.95,rhomax]])
-    integ(lambda data: dinidlintFig7c(data,1), nitn=10,neval=samplesize)
+    limits = [[-5,5],[-5,5],[0.05,amax],[-.95,rhomax],[-.95,rhomax]]
+    integ = trainedIntegrator('dinidlFig7c',limits,lambda data: dinidlintFig7c(data,1),samplesize,maps)
     theta = minimize(lambda theta: integ(lambda data: dinidlintFig7c(data,theta), nitn=10,neval=samplesize).mean,method='brent',options=opt)
-    return integ(lambda data: dinidlintFig7c(data,theta.x), nitn=10,neval=samplesize)
+    res = integ(lambda data: dinidlintFig7c(data,theta.x), nitn=10,neval=samplesize)
+    storeIntegrator('dinidlFig7c',limits,integ,maps)
+    return res
     
 
 # Total transmitted information in Figure 7c
-def infoFig7c(samplesize,amax,rhomax,opt={'xtol':1E-4}):
-    # The integration is performed 10 times in order to train the integrator
-    # and then 10 times more in order to compute the actual values.
+def infoFig7c(samplesize,amax,rhomax,opt={'xtol':1E-4},maps=None):
+    # The integration is performed 10 times (or 2 with a stored map) in order to train the
+    # integrator and then 10 times more in order to compute the actual values.
     # Check the documentaion of vegas for more information.
-    integ = vegas.Integrator([[-5,5],[-5,5],[0.05,amax],[-.95,rhomax],[-.95,rhomax]])
-    integ(infointFig7c, nitn=10,neval=samplesize)
-    return integ(infointFig7c, nitn=10,neval=samplesize)
+    limits = [[-5,5],[-5,5],[0.05,amax],[-.95,rhomax],[-.95,rhomax]]
+    integ = trainedIntegrator('infoFig7c',limits,infointFig7c,samplesize,maps)
+    res = integ(infointFig7c, nitn=10,neval=samplesize)
+    storeIntegrator('infoFig7c',limits,integ,maps)
+    return res
+
+
+# Nodes and weights on [-1,1] of the Gauss-Kronrod rule with 7 nodes and of its embedded
+# Gauss rule with 3 nodes (zero weights on the remaining nodes)
+GK7NODES = numpy.array([-0.9604912687080203,-0.7745966692414834,-0.4342437493468026,0,
+                        0.4342437493468026,0.7745966692414834,0.9604912687080203])
+GK7WEIGHTS = numpy.array([0.1046562260264672,0.2684880898683334,0.4013974147759622,0.4509165386584741,
+                          0.4013974147759622,0.2684880898683334,0.1046562260264672])
+G3WEIGHTS = numpy.array([0,5/9,0,8/9,0,5/9,0])
+
+# Results of the nested quadrature, with the same attributes as those of vegas
+QuadResult = collections.namedtuple('QuadResult',['mean','sdev'])
+
+# Partitions of [-5,5]x[-5,5] for the outer nodes [q,rho1,rho2] in rows of outer. Each
+# square is integrated with the tensor product of the Gauss-Kronrod rule and split in four
+# until the differences with the Gauss rule of both the descriptive loss and the transmitted
+# information are below tol times its area divided by the area of the box, or until maxdepth
+# splits. Returns the owner, squared half-width, and terms of the integrands at the nodes of the squares
+# (see NestedQuadrature), and the values and errors of the transmitted information.
+def nestedPartition(outer,tol,maxdepth):
+    wk = numpy.outer(GK7WEIGHTS,GK7WEIGHTS).ravel()
+    wg = numpy.outer(G3WEIGHTS,G3WEIGHTS).ravel()
+    nx = numpy.repeat(GK7NODES,7); ny = numpy.tile(GK7NODES,7)
+    start = numpy.arange(-3.75,4,2.5)
+    cen = numpy.array([[cx,cy] for cx in start for cy in start]*len(outer))
+    own = numpy.repeat(numpy.arange(len(outer)),len(start)**2)
+    half = numpy.full(len(own),1.25)
+    parts = []
+    for depth in range(0,maxdepth+1):
+        q,rho1,rho2 = [outer[own,col][:,None] for col in range(0,3)]
+        x = cen[:,0,None]+half[:,None]*nx; y = cen[:,1,None]+half[:,None]*ny
+        x1 = x+1; y1 = y+1; x2 = x-1; y2 = y-1
+        det1 = 1-rho1**2; det2 = 1-rho2**2
+        l1 = numpy.log(q/(2*m.pi))-0.5*numpy.log(det1)+(-0.5*(x1**2+y1**2)+rho1*x1*y1)/det1
+        l2 = numpy.log((1-q)/(2*m.pi))-0.5*numpy.log(det2)+(-0.5*(x2**2+y2**2)+rho2*x2*y2)/det2
+        lr = numpy.logaddexp(l1,l2)
+        e1 = numpy.exp(l1); e2 = numpy.exp(l2)
+        terms = e1*(l1-lr)+e2*(l2-lr)
+        s2 = 2*(x+y)
+        lq = numpy.log((1-q)/q)
+        info = terms-e1*numpy.log(q)-e2*numpy.log(1-q)
+        dinid = terms+e1*numpy.logaddexp(0,lq+s2)+e2*numpy.logaddexp(0,-lq-s2)
+        jac = half**2
+        err = numpy.maximum(numpy.abs(dinid@(wk-wg)),numpy.abs(info@(wk-wg)))*jac
+        done = (err<=tol*jac/25) | (depth==maxdepth)
+        parts.append((own[done],jac[done],e1[done],e2[done],terms[done],s2[done],
+                      (info[done]@wk)*jac[done],numpy.abs(info[done]@(wk-wg))*jac[done]))
+        cen,half,own = cen[~done],half[~done]/2,own[~done]
+        shift = numpy.array([[-1,-1],[-1,1],[1,-1],[1,1]])
+        cen = (cen[:,None,:]+half[:,None,None]*shift).reshape(-1,2)
+        half = numpy.repeat(half,4); own = numpy.repeat(own,4)
+        if len(own)==0:
+            break
+    return [numpy.concatenate(vals) for vals in zip(*parts)]
+
+# Deterministic nested quadrature of the integrals of Figures 7b (nrho=1) and 7c (nrho=2)
+# for q in [0.05,amax] and correlation coefficients in [-.95,rhomax]. The integrals over q
+# and each correlation coefficient use Gauss-Legendre rules with order nodes, and those
+# over x and y in [-5,5]x[-5,5], the adaptive cubatures of nestedPartition, computed for
+# the outer nodes in parallel with threads threads. The densities of the responses at the
+# nodes of the cubatures are computed once and shared by all integrals and values of theta.
+# Errors are the sums of the errors of the cubatures, weighted as the outer nodes, plus the
+# errors of the Gauss-Legendre rules along each outer dimension, estimated by extrapolating
+# the decay of the last Legendre coefficients of the interpolants of the outer integrands
+# up to degree 2*order (order must be at least 4).
+class NestedQuadrature:
+
+    def __init__(self,amax,rhomax,nrho,order=8,tol=1E-6,maxdepth=8,threads=None):
+        nodes,weights = numpy.polynomial.legendre.leggauss(order)
+        self.shape = (order,)*(1+nrho)
+        self.axes = [(nodes,weights*(amax-0.05)/2)]+[(nodes,weights*(rhomax+.95)/2)]*nrho
+        grids = numpy.meshgrid(*[(lim[1]-lim[0])/2*nodes+(lim[1]+lim[0])/2
+                                 for lim in [[0.05,amax]]+[[-.95,rhomax]]*nrho],indexing='ij')
+        outer = numpy.stack([grid.ravel() for grid in grids]+[grids[-1].ravel()]*(2-nrho),axis=1)
+        self.weights = numpy.ones(1)
+        for nodes,weights in self.axes:
+            self.weights = numpy.multiply.outer(self.weights,weights)
+        self.weights = self.weights.ravel()
+        
+        # Outer nodes are integrated in chunks, so that numpy works on large arrays
+        self.threads = threads or os.cpu_count() or 1
+        chunks = numpy.array_split(numpy.arange(len(outer)),min(len(outer),4*self.threads))
+        with concurrent.futures.ThreadPoolExecutor(max_workers=self.threads) as pool:
+            parts = list(pool.map(lambda chunk: nestedPartition(outer[chunk],tol,maxdepth),chunks))
+        for chunk,part in zip(chunks,parts):
+            part[0] = chunk[part[0]]
+        self.own,self.jac,self.e1,self.e2,self.terms,self.s2,infok,infoe = \
+            [numpy.concatenate(vals) for vals in zip(*parts)]
+        self.lq = numpy.log((1-outer[self.own,0])/outer[self.own,0])[:,None]
+        self.wk = numpy.outer(GK7WEIGHTS,GK7WEIGHTS).ravel()
+        self.wd = self.wk-numpy.outer(G3WEIGHTS,G3WEIGHTS).ravel()
+        self.infores = self.combine(infok,infoe)
+        bounds = numpy.linspace(0,len(self.own),4*self.threads+1).astype(int)
+        self.chunks = [slice(lo,hi) for lo,hi in zip(bounds[:-1],bounds[1:])]
+
+    # Integral and error from the values and errors of the cubatures of the squares
+    def combine(self,vals,errs):
+        vals = numpy.bincount(self.own,vals,minlength=len(self.weights))
+        errs = numpy.bincount(self.own,errs,minlength=len(self.weights))
+        err = self.weights@errs
+        vals = vals.reshape(self.shape)
+        for axis,(nodes,weights) in enumerate(self.axes):
+            now = vals
+            for other in reversed(range(0,len(self.axes))):
+                if other!=axis:
+                    now = numpy.tensordot(now,self.axes[other][1],axes=([other],[0]))
+            legendre = numpy.polynomial.legendre.legvander(nodes,len(nodes)-1)
+            coef = numpy.abs((numpy.arange(0,len(nodes))+0.5)*((weights*now)@legendre))
+            last,prev = max(coef[-2:]),max(coef[-4:-2])
+            rate = min(1,(last/prev)**0.5) if prev>0 else 1
+            err = err+2*last*rate**(len(nodes)+1)
+        return QuadResult(float(self.weights@vals.ravel()),float(err))
+
+    # Integral of the communication loss for theta
+    def loss(self,theta):
+        def part(chunk):
+            logit = self.lq[chunk]+theta*self.s2[chunk]
+            vals = self.terms[chunk]+self.e1[chunk]*numpy.logaddexp(0,logit)+self.e2[chunk]*numpy.logaddexp(0,-logit)
+            return (vals@self.wk)*self.jac[chunk],numpy.abs(vals@self.wd)*self.jac[chunk]
+        with concurrent.futures.ThreadPoolExecutor(max_workers=self.threads) as pool:
+            parts = list(pool.map(part,self.chunks))
+        return self.combine(*[numpy.concatenate(vals) for vals in zip(*parts)])
+
+    # Descriptive information loss
+    def dinid(self):
+        return self.loss(1)
+
+    # Communication information loss, minimized over theta
+    def dinidl(self,opt={'xtol':1E-4}):
+        theta = minimize(lambda theta: self.loss(theta).mean,method='brent',options=opt)
+        return self.loss(theta.x)
+
+    # Total transmitted information
+    def info(self):
+        return self.infores
+
+
+# Descriptive and communication losses, transmitted information, and difference between the
+# losses in Figure 7b or 7c (fig), sampled by controller until their standard deviations are
+# at most targets['dinid'], targets['dinidl'], targets['info'] and targets['diff'],
+# respectively. Both losses are sampled with the same integrator, trained for the
+# descriptive loss, so that their difference is computed from the same samples.
+def controlledFig7(fig,samplesize,amax,rhomax,targets,controller,opt={'xtol':1E-4},maps=None):
+    lossint,infoint = (dinidlintFig7b,infointFig7b) if fig=='7b' else (dinidlintFig7c,infointFig7c)
+    limits = [[-5,5],[-5,5],[0.05,amax]]+[[-.95,rhomax]]*(1 if fig=='7b' else 2)
+    target = lambda name: targets.get(name,numpy.inf)
+    integ = trainedIntegrator('dinidFig'+fig,limits,lambda data: lossint(data,1),samplesize,maps)
+    theta = minimize(lambda theta: integ(lambda data: lossint(data,theta), nitn=10,neval=samplesize).mean,method='brent',options=opt)
+    def losses(data):
+        dinid = lossint(data,1)
+        dinidl = lossint(data,theta.x)
+        return [dinid,dinidl,dinidl-dinid]
+    dinid,dinidl,diff = controller.run(integ,losses,[target('dinid'),target('dinidl'),target('diff')])
+    storeIntegrator('dinidFig'+fig,limits,integ,maps)
+    integ = trainedIntegrator('infoFig'+fig,limits,infoint,samplesize,maps)
+    info, = controller.run(integ,lambda data: [infoint(data)],[target('info')])
+    storeIntegrator('infoFig'+fig,limits,integ,maps)
+    return dinid,dinidl,info,diff
+
+# Results of the point rhomax of the sweeps of Figure 7b or 7c (fig), as in resultsFig7b/c.
+# The domains of the shared results include the stored maps, which change the training.
+def pointFig7(fig,rhomax,method,target,maps,table):
+    stored = '' if maps is None else ' maps %s %g' % (os.path.abspath(maps.path),maps.radius)
+    if method=='nested':
+        domain = 'Fig%s nested 8 1e-6 0.95' % fig
+        def point():
+            quad = NestedQuadrature(0.95,rhomax,1 if fig=='7b' else 2)
+            aux = [quad.dinid(),quad.dinidl(),quad.info()]
+            return [val for res in aux for val in (res.mean,res.sdev)]
+    elif target is not None:
+        if not isinstance(target,dict):
+            target = dict.fromkeys(['dinid','dinidl','info','diff'],target)
+        domain = 'Fig%s vegas 100000 0.95 target %s%s' % (fig,json.dumps(target,sort_keys=True),stored)
+        def point():
+            controller = SampleController(100000)
+            aux = controlledFig7(fig,100000,0.95,rhomax,target,controller,maps=maps)
+            return [val for res in aux[:3] for val in (res.mean,res.sdev)]+[aux[3].sdev,controller.neval]
+    else:
+        domain = 'Fig%s vegas 100000 0.95%s' % (fig,stored)
+        def point():
+            if fig=='7b':
+                aux = [dinidFig7b(100000,0.95,rhomax,maps=maps),dinidlFig7b(100000,0.95,rhomax,maps=maps),
+                       infoFig7b(100000,0.95,rhomax,maps=maps)]
+            else:
+                aux = [dinidFig7c(100000,0.95,rhomax,maps=maps),dinidlFig7c(100000,0.95,rhomax,maps=maps),
+                       infoFig7c(100000,0.95,rhomax,maps=maps)]
+            return [val for res in aux for val in (res.mean,res.sdev)]
+    return sharedPoint(table,domain,[rhomax],point)
+
+# Stores the results aux of the point ind of the sweeps of Figures 7b and 7c in data
+def storeFig7(data,ind,aux):
+    data['dipmv'][ind],data['dipsd'][ind] = aux[0],aux[1]
+    data['dilmv'][ind],data['dilsd'][ind] = aux[2],aux[3]
+    data['infomv'][ind],data['infosd'][ind] = aux[4],aux[5]
+    if 'diffmv' in data:
+        data['diffmv'][ind],data['diffsd'][ind] = aux[2]-aux[0],aux[6]
+        data['neval'][ind] = int(aux[7])
 
 
 # Compute the descriptive and communication losses for large number of independent
 # information streams in Figure 7c
-def resultsFig7c():
+def resultsFig7c(progress=None,cancel=None,table=None,maps=None,method='vegas',target=None):
 
     # rhomax denotes the maximum value of the interval from which the correlation coefficients
     # are chosen for each independent information stream
@@ -341,28 +698,25 @@ def resultsFig7c():
     datazero = lambda: [0 for ind in range(0,rholen)];
     data = {'rhomax': datazero(),'dipmv':datazero(),'dipsd':datazero(),
             'dilmv':datazero(),'dilsd':datazero(),'infomv':datazero(),'infosd':datazero()}   
+    if target is not None and method!='nested':
+        data.update({'diffmv':datazero(),'diffsd':datazero(),'neval':datazero()})
 
-
+    tracker = SweepProgress(rholen)
     for ind in range(0,rholen):
+        if cancel is not None and cancel.is_set():
+            return truncateResults(data,ind)
         rhomaxnow = rhomax[ind]
         data['rhomax'][ind] = rhomaxnow  
                 
-        # Computes the descriptive information loss
-        aux = dinidFig7c(100000,0.95,rhomaxnow)
-        data['dipmv'][ind] = aux.mean
-        data['dipsd'][ind] = aux.sdev
-
-        # Computes the communication information loss
-        aux = dinidlFig7c(100000,0.95,rhomaxnow)
-        data['dilmv'][ind] = aux.mean
-        data['dilsd'][ind] = aux.sdev
-                   
-        # Computes the transmitted information
-        aux = infoFig7c(100000,0.95,rhomaxnow)
-        data['infomv'][ind] = aux.mean
-        data['infosd'][ind] = aux.sdev
+        # Computes the descriptive and the communication information loss, and the
+        # transmitted information
+        aux = pointFig7('7c',rhomaxnow,method,target,maps,table)
+        storeFig7(data,ind,aux)
         
         print([rhomaxnow,data['dipmv'][ind],data['dilmv'][ind],data['infomv'][ind]])
+        tracker.done(ind,max(data['dipsd'][ind],data['dilsd'][ind],data['infosd'][ind]))
+        if progress is not None:
+            progress(tracker.report())
   
     return data
 
@@ -0,0 +1,377 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Measures how the computations of Figures 4 and 7 scale with the number of threads, both for
+ a fixed problem size (strong scaling) and for a problem size proportional to the number of
+ threads (weak scaling). The workloads are
+
+   fig4       The communication information loss of Figure 4, minimized over theta with
+              the templated cubature of templateCubature.hpp, at a sweep of points
+              [q,rho1,rho2], one point per task (size: number of points).
+   fig4small  The one-dimensional integral of Figure 4 at a sweep of points, a tiny solve
+              per task which exposes the overhead of the scheduler (size: number of points).
+   fig7       Plain Monte Carlo integration of the descriptive loss of Figure 7c, with the
+              samples drawn in chunks by counterRNG.h (size: number of samples).
+   nodes      The loss of Figure 4 at 16 values of theta on a tensor grid of nodes whose
+              terms are computed once and streamed from memory for each theta, as done when
+              the nodes are cached, which is limited by the memory bandwidth for large grids
+              (size: number of nodes per dimension; the number of nodes grows as the square).
+
+ Each result is printed as a line of JSON with fields workload, mode (strong or weak),
+ threads, size, seconds (best wall-clock time among the repeats), speedup (relative to one
+ thread, scaled by the number of threads in weak scaling), efficiency (speedup per
+ thread), idle (for each thread, the wall-clock time not spent in tasks, which includes
+ the waits for other threads and the overhead of the scheduler) and checksum (the result of
+ the computation, which should not depend on the number of threads in strong scaling). The
+ lines can be collected into a file and compared among releases.
+
+ USAGE:
+
+   benchmarkScaling [-t maxthreads] [-s scale] [-r repeats] [workload ...]
+
+ where maxthreads is the maximum number of threads (default, as given by OpenMP), scale
+ multiplies the problem sizes (default 1), repeats is the number of runs from which the
+ best time is taken (default 3), and the workloads are any of the above (default, all).
+
+ The code requires no external library, and can be compiled as follows
+
+   g++ -O2 -fopenmp -o benchmarkScaling benchmarkScaling.cpp -lm
+
+ where g++ can be replaced by any C++ compiler supporting OpenMP.
+
+ VERSION CONTROL
+
+ V1.000 (19 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#include<cstdio>
+#include<cstdlib>
+#include<cstring>
+#include<cmath>
+#include<vector>
+#include<string>
+#include<ctime>
+#ifdef _OPENMP
+#include<omp.h>
+#endif
+#include "templateCubature.hpp"
+#include "figIntegrands.hpp"
+#include "counterRNG.h"
+
+#ifndef _OPENMP
+static inline int omp_get_thread_num(void) { return 0; }
+static inline int omp_get_max_threads(void) { return 1; }
+static inline void omp_set_num_threads(int num) { (void) num; }
+static inline double omp_get_wtime(void) { return (double) clock()/CLOCKS_PER_SEC; }
+#endif
+
+/* Samples of the Monte Carlo integration per task of the workload fig7 */
+#define BENCH_CHUNK 4096
+
+/* Timing of one run: wall-clock time and time spent in tasks by each thread */
+struct BenchTiming
+{
+    double              wall;
+    std::vector<double> busy;
+    double              checksum;
+};
+
+/* Parameters [q,rho1,rho2] of the point ind of a sweep of num points over Figure 4 */
+static void benchFig4Par(size_t ind, size_t num, double par[3])
+{
+    double  u = (ind+0.5)/num;
+
+    par[0] = 0.1 + 0.8*u;
+    par[1] = -0.9 + 1.8*fmod(7*u, 1);
+    par[2] = -0.9 + 1.8*fmod(13*u, 1);
+}
+
+/* Communication information loss of Figure 4, minimized over theta, at num sweep points */
+static void benchFig4(size_t num, BenchTiming &tim)
+{
+    double  sum = 0;
+    double  start = omp_get_wtime();
+    long    ind;
+
+    #pragma omp parallel reduction(+:sum)
+    {
+        double  busy = 0, t0, th, par[3];
+
+        #pragma omp for schedule(dynamic,1) nowait
+        for(ind=0; ind<(long)num; ind++)
+        {
+            t0 = omp_get_wtime();
+            benchFig4Par(ind, num, par);
+            sum  += minimizeTheta(FigLoss(par), &th);
+            busy += omp_get_wtime()-t0;
+        }
+        tim.busy[omp_get_thread_num()] = busy;
+    }
+    tim.wall     = omp_get_wtime()-start;
+    tim.checksum = sum;
+}
+
+/* One-dimensional integral of Figure 4 at num sweep points, with theta between 0.5 and 1.5,
+   a tiny solve per task that exposes the overhead of the scheduler */
+static void benchFig4Small(size_t num, BenchTiming &tim)
+{
+    const double    xmin[1] = {-5};
+    const double    xmax[1] = {5};
+    double          sum = 0;
+    double          start = omp_get_wtime();
+    long            ind;
+
+    #pragma omp parallel reduction(+:sum)
+    {
+        double  busy = 0, t0, val, err, par[3];
+
+        #pragma omp for schedule(dynamic,1) nowait
+        for(ind=0; ind<(long)num; ind++)
+        {
+            t0 = omp_get_wtime();
+            benchFig4Par(ind, num, par);
+            hcubatureT<1>(FigIntegrand<1>(1-par[0], par[0], 0, 0, 0.5+(ind+0.5)/num), xmin, xmax, 1000, 1E-6, 1E-3, val, err);
+            sum  += val;
+            busy += omp_get_wtime()-t0;
+        }
+        tim.busy[omp_get_thread_num()] = busy;
+    }
+    tim.wall     = omp_get_wtime()-start;
+    tim.checksum = sum;
+}
+
+/* Plain Monte Carlo integration of the descriptive loss of Figure 7c with num samples over
+   the domain of resultsFig7c with rhomax = 0.5. Samples are drawn with counterRNG.h, so
+   the result does not depend on the number of threads. */
+static void benchFig7(size_t num, BenchTiming &tim)
+{
+    const double    lo[5] = {-5,-5,0.05,-0.95,-0.95};
+    const double    hi[5] = {5,5,0.95,0.5,0.5};
+    Fig7Integrand   f(1);
+    uint64_t        key = counterKey(1, 0);
+    long            nchunk = (long)((num+BENCH_CHUNK-1)/BENCH_CHUNK);
+    double          vol = 1, sum = 0;
+    double          start = omp_get_wtime();
+    long            ind;
+    unsigned        j;
+
+    for(j=0; j<5; j++) vol *= hi[j]-lo[j];
+
+    #pragma omp parallel reduction(+:sum)
+    {
+        double      busy = 0, t0, x[5];
+        size_t      i, end;
+        unsigned    jj;
+
+        #pragma omp for schedule(dynamic,1) nowait
+        for(ind=0; ind<nchunk; ind++)
+        {
+            t0  = omp_get_wtime();
+            end = (size_t)(ind+1)*BENCH_CHUNK<num ? (size_t)(ind+1)*BENCH_CHUNK : num;
+            for(i=(size_t)ind*BENCH_CHUNK; i<end; i++)
+            {
+                for(jj=0; jj<5; jj++) x[jj] = lo[jj] + (hi[jj]-lo[jj])*counterUniform(key, 5*(uint64_t)i+jj);
+                sum += f(x);
+            }
+            busy += omp_get_wtime()-t0;
+        }
+        tim.busy[omp_get_thread_num()] = busy;
+    }
+    tim.wall     = omp_get_wtime()-start;
+    tim.checksum = sum*vol/num;
+}
+
+/* Loss of Figure 4 at 16 values of theta on a cached tensor grid of num x num nodes, whose
+   terms are stored once and streamed from memory for each theta, as in the modes that
+   cache the nodes. For large grids, this workload is limited by the memory bandwidth. */
+static void benchNodes(size_t num, BenchTiming &tim)
+{
+    const unsigned      nth = 16;
+    size_t              nn = num*num;
+    std::vector<double> w(nn), sa(nn), sb(nn), ps1(nn), ps2(nn);
+    double              h = 10.0/num, x[2], sum = 0, start;
+    long                ind;
+
+    for(ind=0; ind<(long)nn; ind++)
+    {
+        x[0] = -5 + h*(ind/num+0.5);
+        x[1] = -5 + h*(ind%num+0.5);
+        w[ind]   = h*h;
+        sa[ind]  = -0.5*((x[0]+1)*(x[0]+1)+(x[1]+1)*(x[1]+1));
+        sb[ind]  = -0.5*((x[0]-1)*(x[0]-1)+(x[1]-1)*(x[1]-1));
+        ps1[ind] = 0.3/(2*M_PI*sqrt(0.75))*exp((-0.5*((x[0]+1)*(x[0]+1)+(x[1]+1)*(x[1]+1))+0.5*(x[0]+1)*(x[1]+1))/0.75);
+        ps2[ind] = 0.7/(2*M_PI*sqrt(0.75))*exp((-0.5*((x[0]-1)*(x[0]-1)+(x[1]-1)*(x[1]-1))+0.5*(x[0]-1)*(x[1]-1))/0.75);
+    }
+
+    start = omp_get_wtime();
+    #pragma omp parallel reduction(+:sum)
+    {
+        double      busy = 0, t0, th, r;
+        unsigned    k;
+
+        for(k=0; k<nth; k++)
+        {
+            th = 0.5 + k/(double)nth;
+            t0 = omp_get_wtime();
+            #pragma omp for schedule(static) nowait
+            for(ind=0; ind<(long)nn; ind++)
+            {
+                /* ps1*log(1+exp(th*(sb-sa))*0.7/0.3) - ps1*log(1+ps2/ps1) and likewise for s2 */
+                r    = ps2[ind]/ps1[ind];
+                sum += w[ind]*(ps1[ind]*(log1p(exp(th*(sb[ind]-sa[ind]))*0.7/0.3) - log1p(r))
+                             + ps2[ind]*(log1p(exp(th*(sa[ind]-sb[ind]))*0.3/0.7) - log1p(1/r)));
+            }
+            busy += omp_get_wtime()-t0;
+            #pragma omp barrier
+        }
+        tim.busy[omp_get_thread_num()] = busy;
+    }
+    tim.wall     = omp_get_wtime()-start;
+    tim.checksum = sum;
+}
+
+typedef void (*BenchFun)(size_t, BenchTiming&);
+
+struct BenchWorkload
+{
+    const char  *name;
+    BenchFun    fun;
+    size_t      size;       /* problem size for scale 1 */
+};
+
+static const BenchWorkload benchWorkloads[] =
+{
+    {"fig4",     benchFig4,      256},
+    {"fig4small",benchFig4Small, 4096},
+    {"fig7",     benchFig7,      1<<22},
+    {"nodes",    benchNodes,     1024}
+};
+
+/* Best of reps runs of the workload at the given size and number of threads */
+static BenchTiming benchRun(const BenchWorkload &wl, size_t size, int threads, unsigned reps)
+{
+    BenchTiming best, now;
+    unsigned    rep;
+
+    omp_set_num_threads(threads);
+    best.wall = INFINITY;
+    for(rep=0; rep<reps; rep++)
+    {
+        now.busy.assign(threads, 0);
+        wl.fun(size, now);
+        if(now.wall<best.wall) best = now;
+    }
+    return best;
+}
+
+/* Prints the result of a run as a line of JSON */
+static void benchPrint(const BenchWorkload &wl, const char *mode, size_t size, int threads, const BenchTiming &tim, double speedup)
+{
+    int     ind;
+
+    printf("{\"workload\":\"%s\",\"mode\":\"%s\",\"threads\":%d,\"size\":%lu,\"seconds\":%.6g,"
+           "\"speedup\":%.4g,\"efficiency\":%.4g,\"idle\":[",
+           wl.name, mode, threads, (unsigned long)size, tim.wall, speedup, speedup/threads);
+    for(ind=0; ind<threads; ind++)
+        printf("%s%.6g", ind ? "," : "", tim.wall-tim.busy[ind]>0 ? tim.wall-tim.busy[ind] : 0);
+    printf("],\"checksum\":%.12g}\n", tim.checksum);
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[])
+{
+    int         maxthreads = omp_get_max_threads();
+    double      scale = 1;
+    unsigned    reps = 3;
+    int         threads, arg;
+    size_t      ind, size;
+    std::vector<std::string>    names;
+    BenchTiming tim, base;
+
+    for(arg=1; arg<argc; arg++)
+    {
+        if(!strcmp(argv[arg],"-t") && arg+1<argc) maxthreads = atoi(argv[++arg]);
+        else if(!strcmp(argv[arg],"-s") && arg+1<argc) scale = atof(argv[++arg]);
+        else if(!strcmp(argv[arg],"-r") && arg+1<argc) reps = (unsigned) atoi(argv[++arg]);
+        else if(argv[arg][0]=='-')
+        {
+            fprintf(stderr, "usage: %s [-t maxthreads] [-s scale] [-r repeats] [workload ...]\n", argv[0]);
+            return 1;
+        }
+        else names.push_back(argv[arg]);
+    }
+    if(maxthreads<1 || !(scale>0) || reps<1)
+    {
+        fprintf(stderr, "The number of threads, the scale and the repeats must be positive\n");
+        return 1;
+    }
+
+    for(ind=0; ind<sizeof(benchWorkloads)/sizeof(BenchWorkload); ind++)
+    {
+        const BenchWorkload &wl = benchWorkloads[ind];
+        bool                run = names.empty();
+
+        for(size_t k=0; k<names.size(); k++) run = run || names[k]==wl.name;
+        if(!run) continue;
+
+        /* Strong scaling, fixed problem size */
+        size = (size_t) ceil(wl.size*scale);
+        for(threads=1; threads<=maxthreads; threads++)
+        {
+            tim = benchRun(wl, size, threads, reps);
+            if(threads==1) base = tim;
+            benchPrint(wl, "strong", size, threads, tim, base.wall/tim.wall);
+        }
+
+        /* Weak scaling, problem size proportional to the number of threads. For the
+           workload nodes, the size is the side of the grid. */
+        for(threads=1; threads<=maxthreads; threads++)
+        {
+            size = (size_t) ceil(wl.size*scale*(wl.fun==benchNodes ? sqrt((double)threads) : threads));
+            tim  = benchRun(wl, size, threads, reps);
+            if(threads==1) base = tim;
+            benchPrint(wl, "weak", size, threads, tim, threads*base.wall/tim.wall);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Counter-based random numbers.
+
+ Each random number is a fixed function (a 64-bit mixing hash) of a key, which identifies
+ the stream (e.g., a seed and a population), and a counter, which identifies the number
+ within the stream (e.g., a trial and a neuron). There is no state to share or advance, so
+ the numbers can be generated in any order, by any number of threads, and the results do
+ not depend on how the work is distributed among them.
+
+ This file is included by the mex-files that need it.
+
+ VERSION CONTROL
+
+ V1.000 (19 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#ifndef COUNTERRNG_H
+#define COUNTERRNG_H
+
+#include<math.h>
+#include<stdint.h>
+
+/* Key of the stream identified by the pair (seed,stream) */
+static inline uint64_t counterKey(uint64_t seed, uint64_t stream)
+{
+    uint64_t    z = seed + 0x9E3779B97F4A7C15ULL*(stream+1);
+
+    z = (z^(z>>30))*0xBF58476D1CE4E5B9ULL;
+    z = (z^(z>>27))*0x94D049BB133111EBULL;
+    return z^(z>>31);
+}
+
+/* Random 64-bit integer number ctr of the stream key (splitmix64 finalizer applied twice,
+   so that consecutive counters and keys are decorrelated) */
+static inline uint64_t counterBits(uint64_t key, uint64_t ctr)
+{
+    uint64_t    z = key ^ (ctr*0x9E3779B97F4A7C15ULL);
+
+    z = (z^(z>>30))*0xBF58476D1CE4E5B9ULL;
+    z = (z^(z>>27))*0x94D049BB133111EBULL;
+    z ^= z>>31;
+    z = (z+0x9E3779B97F4A7C15ULL+key);
+    z = (z^(z>>30))*0xBF58476D1CE4E5B9ULL;
+    z = (z^(z>>27))*0x94D049BB133111EBULL;
+    return z^(z>>31);
+}
+
+/* Uniform random number in (0,1) */
+static inline double counterUniform(uint64_t key, uint64_t ctr)
+{
+    return ((counterBits(key, ctr)>>11)+0.5)*(1.0/9007199254740992.0);
+}
+
+/* Pair of independent standard normal random numbers obtained from the uniform numbers
+   ctr and ctr+1 through the Box-Muller transform */
+static inline void counterNormal2(uint64_t key, uint64_t ctr, double *z0, double *z1)
+{
+    double      rad = sqrt(-2*log(counterUniform(key, ctr)));
+    double      ang = 2*M_PI*counterUniform(key, ctr+1);
+
+    *z0 = rad*cos(ang);
+    *z1 = rad*sin(ang);
+}
+
+#endif
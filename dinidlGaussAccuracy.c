@@ -0,0 +1,278 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Estimates, by simulating trials, the fraction of correct decisions (accuracy) of the
+ optimal decoder and of NI decoders, for any number of populations with arbitrary Gaussian
+ responses to a binary stimulus, together with their confusion matrices and confidence
+ intervals. This complements the information losses computed by the other mex-files with
+ a quantity that can be compared directly with behavioural and decoding experiments.
+
+ In each trial, a stimulus is drawn with probabilities q and 1-q, and the response is drawn
+ from its Gaussian distribution. The optimal decoder chooses the stimulus with the largest
+ posterior, namely s1 whenever lam + log(q/(1-q)) > 0, whereas the NI decoder with parameter
+ theta chooses s1 whenever theta*ell + log(q/(1-q)) > 0 (see llrTable.h). Note that theta
+ does not affect the decisions of NI decoders when q = 1/2.
+
+ The trials are simulated in batches. Within each batch, the responses are drawn in the
+ whitened coordinates of their stimulus, where the log-likelihood ratios are quadratic
+ forms evaluated simultaneously for all trials of the batch (see gaussModel.h), in loops
+ that the compiler can vectorize. Random numbers are counter-based (see counterRNG.h), so
+ the batches are distributed among the available cores and the results depend only on the
+ seed, not on the number of cores.
+
+ USAGE:
+
+   res = dinidlGaussAccuracy(pops,ntrials,theta,seed)
+
+ where pops is a struct array with one element per population and fields q, mu1, mu2, C1 and
+ C2 (see dinidlGaussLLR.c), ntrials is the number of trials simulated per population
+ (default 1E6), theta contains the values of theta of the NI decoders of each population
+ (one per population, or empty to use the values minimizing the communication information
+ loss, as computed by dinidlGaussPops), and seed is a nonnegative integer (default 0). The
+ output res is a struct with fields
+
+   theta      values of theta used by the NI decoders
+   accuracy   3 x numel(pops) matrix with the fraction of correct decisions of the optimal
+              decoder, the NI decoder with theta=1 and the NI decoder with the given theta
+   lower      lower limits of the 95% Wilson confidence intervals of the accuracies
+   upper      upper limits of the 95% Wilson confidence intervals of the accuracies
+   confusion  2 x 2 x 3 x numel(pops) array with the number of trials in which each
+              stimulus (first index) was decoded as each stimulus (second index)
+
+ The code requires the following library
+
+ - GSL (https://www.gnu.org/software/gsl/)
+
+ It should be installed wherever #include looks for headers, or
+ else, the folders in the #include statements within the c-files
+ (mex-files) should be modified.
+
+ The code can be compiled as follows
+
+   mex -v GCC='/usr/bin/gcc-4.7' CFLAGS='$CFLAGS -fopenmp' LDFLAGS='$LDFLAGS -fopenmp' -lgsl -lgslcblas -lm dinidlGaussAccuracy.c
+
+ where you should replace /usr/bin/gcc-4.7 for the appropriate folder
+ and C compiler compatible with your Matlab installation. The OpenMP flags are optional
+ and distribute the batches of trials among the available cores.
+
+ VERSION CONTROL
+
+ V1.000 (19 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#include<mex.h>
+#include<math.h>
+#include<stdint.h>
+#include "gaussModel.h"
+#include "counterRNG.h"
+
+/* Number of trials per batch */
+#define ACC_BATCH 256
+
+/* Number of decoders: optimal, NI with theta=1 and NI with the given theta */
+#define ACC_DEC 3
+
+/* Quantile of the standard normal distribution for 95% confidence intervals */
+#define ACC_Z 1.959963984540054
+
+/* Simulates the trials first to first+num-1 of the population, with num <= ACC_BATCH, and
+   adds the outcomes to count[dec][s][r], the number of trials in which the stimulus s was
+   decoded as r by the decoder dec. The workspace z must hold d+1 rows of ACC_BATCH values. */
+void accBatch(const gaussModel *pop, double theta, uint64_t key, uint64_t first, unsigned num, double *z, double count[ACC_DEC][2][2])
+{
+    unsigned    d = pop->d;
+    unsigned    npair = (d+1)/2;
+    uint64_t    width = 1+2*(uint64_t)npair;
+    double      val[2][ACC_BATCH];
+    double      prior = log(pop->q/(1-pop->q));
+    unsigned    nstim[2] = {0,0};
+    unsigned    beg, end, s, f, i, j, t, p;
+    const double *K, *beta;
+    double      gamma, sum;
+
+    /* The stimuli are drawn first, and the trials are sorted by stimulus. Since the
+       whitened responses are independent of the stimulus, they are drawn afterwards. */
+    for(t=0; t<num; t++)
+        nstim[counterUniform(key, (first+t)*width)<pop->q ? 0 : 1]++;
+    for(t=0; t<num; t++)
+        for(p=0; p<npair; p++)
+            counterNormal2(key, (first+t)*width+1+2*p, z+(2*p)*ACC_BATCH+t, z+(2*p+1)*ACC_BATCH+t);
+
+    for(s=0; s<2; s++)
+    {
+        beg = s==0 ? 0 : nstim[0];
+        end = s==0 ? nstim[0] : num;
+        for(f=0; f<2; f++)
+        {
+            K     = pop->KA[s][f];
+            beta  = pop->beta[s][f];
+            gamma = pop->gamma[s][f];
+            #pragma omp simd
+            for(t=beg; t<end; t++) val[f][t] = gamma;
+            for(i=0; i<d; i++)
+            {
+                /* val += z_i*(beta_i + K_ii*z_i + 2*sum_{j<i} K_ij*z_j) */
+                #pragma omp simd private(sum,j)
+                for(t=beg; t<end; t++)
+                {
+                    sum = beta[i] + K[i*d+i]*z[i*ACC_BATCH+t];
+                    for(j=0; j<i; j++) sum += 2*K[i*d+j]*z[j*ACC_BATCH+t];
+                    val[f][t] += sum*z[i*ACC_BATCH+t];
+                }
+            }
+        }
+
+        for(t=beg; t<end; t++)
+        {
+            count[0][s][val[0][t]+prior>0 ? 0 : 1]++;
+            count[1][s][val[1][t]+prior>0 ? 0 : 1]++;
+            count[2][s][theta*val[1][t]+prior>0 ? 0 : 1]++;
+        }
+    }
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    const char  *fields[5] = {"theta","accuracy","lower","upper","confusion"};
+    mwSize      dims[4] = {2,2,ACC_DEC,0};
+    unsigned    npop, dec;
+    long        indp, nbatch, indb;
+    double      ntrials = 1E6;
+    double      seed = 0;
+    double      *theta, *acc, *lower, *upper, *conf;
+    double      ncorrect, phat, centre, half;
+    gaussModel  **pop;
+
+    if(nrhs<1) mexErrMsgTxt("Please specify the populations");
+    if(nrhs>1 && !mxIsEmpty(prhs[1])) ntrials = floor(mxGetScalar(prhs[1]));
+    if(nrhs>3 && !mxIsEmpty(prhs[3])) seed = floor(mxGetScalar(prhs[3]));
+    if(!(ntrials>=1)) mexErrMsgTxt("The number of trials must be positive");
+    if(!(seed>=0)) mexErrMsgTxt("The seed must be a nonnegative integer");
+
+    npop = (unsigned) mxGetNumberOfElements(prhs[0]);
+    if(npop==0) mexErrMsgTxt("Please specify at least one population");
+    if(nrhs>2 && !mxIsEmpty(prhs[2]) && mxGetNumberOfElements(prhs[2])!=npop)
+        mexErrMsgTxt("Please specify one value of theta per population");
+    dims[3] = npop;
+
+    plhs[0] = mxCreateStructMatrix(1,1,5,fields);
+    mxSetField(plhs[0],0,"theta",    mxCreateDoubleMatrix(1,npop,mxREAL));
+    mxSetField(plhs[0],0,"accuracy", mxCreateDoubleMatrix(ACC_DEC,npop,mxREAL));
+    mxSetField(plhs[0],0,"lower",    mxCreateDoubleMatrix(ACC_DEC,npop,mxREAL));
+    mxSetField(plhs[0],0,"upper",    mxCreateDoubleMatrix(ACC_DEC,npop,mxREAL));
+    mxSetField(plhs[0],0,"confusion",mxCreateNumericArray(4,dims,mxDOUBLE_CLASS,mxREAL));
+    theta = mxGetPr(mxGetField(plhs[0],0,"theta"));
+    acc   = mxGetPr(mxGetField(plhs[0],0,"accuracy"));
+    lower = mxGetPr(mxGetField(plhs[0],0,"lower"));
+    upper = mxGetPr(mxGetField(plhs[0],0,"upper"));
+    conf  = mxGetPr(mxGetField(plhs[0],0,"confusion"));
+
+    /* The Matlab API is not thread safe, so the populations are read beforehand */
+    pop = (gaussModel**) mxMalloc(npop*sizeof(gaussModel*));
+    for(indp=0; indp<npop; indp++)
+    {
+        pop[indp] = gaussModelFromStruct(prhs[0], indp);
+        if(nrhs>2 && !mxIsEmpty(prhs[2])) theta[indp] = mxGetPr(prhs[2])[indp];
+    }
+
+    /* Values of theta minimizing the communication information loss (see dinidlGaussPops) */
+    if(nrhs<3 || mxIsEmpty(prhs[2]))
+    {
+        #pragma omp parallel for schedule(dynamic)
+        for(indp=0; indp<npop; indp++)
+        {
+            llrGrid     *grid = gaussModelGrid(pop[indp], 512);
+            llrDIPar    popdi;
+
+            popdi.tab = llrGridToTable(grid, 0);
+            popdi.q   = pop[indp]->q;
+            llrGridFree(grid);
+            llrMinimize(llrDITheta, &popdi, theta+indp);
+            llrTableFree((llrTable*) popdi.tab);
+        }
+    }
+
+    nbatch = (long) ceil(ntrials/ACC_BATCH);
+    for(indp=0; indp<npop; indp++)
+    {
+        uint64_t    key = counterKey((uint64_t) seed, (uint64_t) indp);
+        double      *cnt = conf + (size_t)indp*4*ACC_DEC;
+
+        #pragma omp parallel
+        {
+            double      count[ACC_DEC][2][2] = {{{0,0},{0,0}},{{0,0},{0,0}},{{0,0},{0,0}}};
+            double      *z = (double*) malloc((size_t)(pop[indp]->d+1)*ACC_BATCH*sizeof(double));
+            unsigned    dn, sn, rn;
+            unsigned    num;
+
+            #pragma omp for schedule(static) nowait
+            for(indb=0; indb<nbatch; indb++)
+            {
+                num = (unsigned)(indb==nbatch-1 ? ntrials-(double)indb*ACC_BATCH : ACC_BATCH);
+                accBatch(pop[indp], theta[indp], key, (uint64_t)indb*ACC_BATCH, num, z, count);
+            }
+            free(z);
+
+            #pragma omp critical
+            for(dn=0; dn<ACC_DEC; dn++)
+                for(sn=0; sn<2; sn++)
+                    for(rn=0; rn<2; rn++)
+                        cnt[dn*4+rn*2+sn] += count[dn][sn][rn];
+        }
+
+        /* Accuracies and Wilson confidence intervals */
+        for(dec=0; dec<ACC_DEC; dec++)
+        {
+            ncorrect = cnt[dec*4] + cnt[dec*4+3];
+            phat     = ncorrect/ntrials;
+            centre   = (phat + ACC_Z*ACC_Z/(2*ntrials))/(1 + ACC_Z*ACC_Z/ntrials);
+            half     = ACC_Z*sqrt(phat*(1-phat)/ntrials + ACC_Z*ACC_Z/(4*ntrials*ntrials))/(1 + ACC_Z*ACC_Z/ntrials);
+            acc[indp*ACC_DEC+dec]   = phat;
+            lower[indp*ACC_DEC+dec] = centre-half;
+            upper[indp*ACC_DEC+dec] = centre+half;
+        }
+    }
+
+    for(indp=0; indp<npop; indp++) gaussModelFree(pop[indp]);
+    mxFree(pop);
+}
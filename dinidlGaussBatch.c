@@ -0,0 +1,637 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Computes the communication information losses depicted in Figure 4 of the aforementioned
+ publication, as done by dinidlGaussTheta, for many values of the parameters at once.
+
+ Instead of solving each point of the sweep separately, the minimizations over theta of
+ all points advance together, in rounds. In each round, each point that has not yet
+ converged requests the loss at one or more values of theta: the three initial values,
+ the values expanding the minimization interval, or the next point of Brent's method,
+ which is implemented here in reverse-communication form so that its evaluations can be
+ deferred. All requests of the round are then computed together with a fixed
+ Gauss-Legendre product rule on the same domain as dinidlGaussTheta, looping over the
+ nodes and, innermost, over the requests, which yields a dense loop that the compiler can
+ vectorize. The nodes are distributed among the available cores. Points that converge
+ leave the batch.
+
+ USAGE:
+
+   [di,theta] = dinidlGaussBatch(par,nodes)
+   [di,theta,info] = dinidlGaussBatch([rho1,rho2],nodes,q)
+
+ where par is a matrix with one row [q,rho1,rho2] per point (see dinidlGaussTheta), and
+ nodes is the number of Gauss-Legendre nodes along each dimension (default 64). The
+ outputs are column vectors with the communication information loss of each point and the
+ value of theta attaining it.
+
+ The second form sweeps the vector q for fixed correlation coefficients. Because q enters
+ the integrands only as a factor multiplying the class-conditional densities, these
+ densities are computed once per node and shared by all values of q and theta, leaving
+ one exponential and two logarithms per node and evaluation instead of four exponentials
+ and one logarithm. The optional output info contains the information transmitted for
+ each value of q, as given by infoGauss([q,rho1,rho2])+infoGauss(1-q), computed from
+ the same nodes.
+
+ The code requires the following library
+
+ - GSL (https://www.gnu.org/software/gsl/)
+
+ It should be installed wherever #include looks for headers, or
+ else, the folders in the #include statements within the c-files
+ (mex-files) should be modified.
+
+ The code can be compiled as follows
+
+   mex -v GCC='/usr/bin/gcc-4.7' CFLAGS='$CFLAGS -fopenmp' LDFLAGS='$LDFLAGS -fopenmp' -lgsl -lgslcblas -lm dinidlGaussBatch.c
+
+ where you should replace /usr/bin/gcc-4.7 for the appropriate folder
+ and C compiler compatible with your Matlab installation. The OpenMP flags are optional.
+
+ VERSION CONTROL
+
+ V1.000 (19 Oct 2026)
+ V1.001 Sweeps over q share the class-conditional densities (19 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#include<mex.h>
+#include<math.h>
+#include<string.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_min.h>
+
+/* Phases of the minimization of each point */
+enum {BATCH_PROBE, BATCH_LEFT, BATCH_RIGHT, BATCH_INIT, BATCH_BRENT, BATCH_DONE};
+
+/* Maximum number of iterations of Brent's method */
+#define BATCH_MAXITER 100
+
+/* Minimization of the loss of one point over theta. The fields of Brent's method follow
+   the notation of gsl_min_fminimizer_brent. */
+typedef struct
+{
+    int     phase;
+    int     iter;
+    double  thl, thm, thr;
+    double  dil, dim, dir;
+    double  v, w, d, e, fv, fw;
+    double  u;
+} batchPoint;
+
+/* Gauss-Legendre nodes and weights on [lo,hi] */
+void gaussLegendre(unsigned n, double lo, double hi, double *x, double *w)
+{
+    unsigned    i, j;
+    double      z, z1, p1, p2, p3, pp;
+
+    for(i=0; i<(n+1)/2; i++)
+    {
+        z = cos(M_PI*(i+0.75)/(n+0.5));
+        do
+        {
+            p1 = 1;
+            p2 = 0;
+            for(j=0; j<n; j++)
+            {
+                p3 = p2;
+                p2 = p1;
+                p1 = ((2*j+1)*z*p2-j*p3)/(j+1);
+            }
+            pp = n*(z*p1-p2)/(z*z-1);
+            z1 = z;
+            z  = z1-p1/pp;
+        }
+        while(fabs(z-z1)>1E-15);
+        x[i]     = 0.5*(lo+hi)-0.5*(hi-lo)*z;
+        x[n-1-i] = 0.5*(lo+hi)+0.5*(hi-lo)*z;
+        w[i] = w[n-1-i] = (hi-lo)/((1-z*z)*pp*pp);
+    }
+}
+
+/* Proposes the next value of theta of Brent's method (see brent_iterate in GSL) */
+double brentPropose(batchPoint *pt)
+{
+    const double golden = 0.3819660;
+    double  z = pt->thm;
+    double  d = pt->e;
+    double  e = pt->d;
+    double  tolerance = 1.4901161193847656E-08*fabs(z);
+    double  midpoint = 0.5*(pt->thl+pt->thr);
+    double  p = 0, q = 0, r = 0, u;
+
+    if(fabs(e)>tolerance)
+    {
+        r = (z-pt->w)*(pt->dim-pt->fv);
+        q = (z-pt->v)*(pt->dim-pt->fw);
+        p = (z-pt->v)*q-(z-pt->w)*r;
+        q = 2*(q-r);
+        if(q>0) p = -p; else q = -q;
+        r = e;
+        e = d;
+    }
+
+    if(fabs(p)<fabs(0.5*q*r) && p<q*(z-pt->thl) && p<q*(pt->thr-z))
+    {
+        d = p/q;
+        u = z+d;
+        if((u-pt->thl)<2*tolerance || (pt->thr-u)<2*tolerance) d = z<midpoint ? tolerance : -tolerance;
+    }
+    else
+    {
+        e = z<midpoint ? pt->thr-z : -(z-pt->thl);
+        d = golden*e;
+    }
+
+    pt->e = e;
+    pt->d = d;
+    return fabs(d)>=tolerance ? z+d : z+(d>0 ? tolerance : -tolerance);
+}
+
+/* Updates Brent's method with the loss fu at the proposed value u */
+void brentAccept(batchPoint *pt, double u, double fu)
+{
+    if(fu<=pt->dim)
+    {
+        if(u<pt->thm) pt->thr = pt->thm; else pt->thl = pt->thm;
+        pt->v  = pt->w;
+        pt->fv = pt->fw;
+        pt->w  = pt->thm;
+        pt->fw = pt->dim;
+        pt->thm = u;
+        pt->dim = fu;
+    }
+    else
+    {
+        if(u<pt->thm) pt->thl = u; else pt->thr = u;
+        if(fu<=pt->fw || pt->w==pt->thm)
+        {
+            pt->v  = pt->w;
+            pt->fv = pt->fw;
+            pt->w  = u;
+            pt->fw = fu;
+        }
+        else if(fu<=pt->fv || pt->v==pt->thm || pt->v==pt->w)
+        {
+            pt->v  = u;
+            pt->fv = fu;
+        }
+    }
+}
+
+/* Advances the point with the losses di of its requests, and writes its new requests in th.
+   Returns the number of new requests. */
+unsigned batchAdvance(batchPoint *pt, const double *di, double *th)
+{
+    switch(pt->phase)
+    {
+        case BATCH_PROBE:
+            pt->dil = di[0];
+            pt->dim = di[1];
+            pt->dir = di[2];
+            pt->phase = BATCH_LEFT;
+            break;
+        case BATCH_LEFT:
+            pt->dil = di[0];
+            break;
+        case BATCH_RIGHT:
+            pt->dir = di[0];
+            break;
+        case BATCH_INIT:
+            pt->fv = pt->fw = di[0];
+            pt->phase = BATCH_BRENT;
+            break;
+        case BATCH_BRENT:
+            brentAccept(pt, pt->u, di[0]);
+            pt->iter++;
+            break;
+    }
+
+    /* Looking for lower limit of minimization interval */
+    if(pt->phase==BATCH_LEFT)
+    {
+        if(pt->dil<pt->dim)
+        {
+            pt->dir = pt->dim; pt->dim = pt->dil;
+            pt->thr = pt->thm; pt->thm = pt->thl;
+            th[0] = pt->thl *= 2;
+            return 1;
+        }
+        pt->phase = BATCH_RIGHT;
+    }
+
+    /* Looking for upper limit of minimization interval */
+    if(pt->phase==BATCH_RIGHT)
+    {
+        if(pt->dir<pt->dim)
+        {
+            pt->dil = pt->dim; pt->dim = pt->dir;
+            pt->thl = pt->thm; pt->thm = pt->thr;
+            th[0] = pt->thr *= 2;
+            return 1;
+        }
+        pt->phase = BATCH_INIT;
+        pt->d = pt->e = 0;
+        th[0] = pt->v = pt->w = pt->thl + 0.3819660*(pt->thr-pt->thl);
+        return 1;
+    }
+
+    if(pt->phase==BATCH_BRENT)
+    {
+        if(gsl_min_test_interval(pt->thl, pt->thr, 1E-6, 1E-3) != GSL_CONTINUE || pt->iter>=BATCH_MAXITER)
+        {
+            pt->phase = BATCH_DONE;
+            return 0;
+        }
+        th[0] = pt->u = brentPropose(pt);
+        return 1;
+    }
+    return 0;
+}
+
+/* Losses of all requests, the request r having parameters par[3*r..3*r+2] and theta th[r].
+   The integrands are those of dinidlGaussTheta, written in terms of logarithms. */
+void batchLosses(unsigned nreq, const double *par, const double *th, unsigned nodes, const double *x, const double *wx, double *di)
+{
+    double  *coef = (double*) malloc(9*(size_t)nreq*sizeof(double));
+    double  *a1 = coef, *a2 = coef+nreq, *c1 = coef+2*nreq, *c2 = coef+3*nreq;
+    double  *l1 = coef+4*nreq, *l2 = coef+5*nreq, *n1 = coef+6*nreq, *n2 = coef+7*nreq;
+    double  *tv = coef+8*nreq;
+    unsigned r;
+
+    for(r=0; r<nreq; r++)
+    {
+        a1[r] = 1.0/(1.0-par[3*r+1]*par[3*r+1]);
+        a2[r] = 1.0/(1.0-par[3*r+2]*par[3*r+2]);
+        c1[r] = par[3*r+1]*a1[r];
+        c2[r] = par[3*r+2]*a2[r];
+        l1[r] = log(par[3*r]);
+        l2[r] = log(1-par[3*r]);
+        n1[r] = l1[r] + 0.5*log(a1[r]) - log(2*M_PI);
+        n2[r] = l2[r] + 0.5*log(a2[r]) - log(2*M_PI);
+        tv[r] = th[r];
+        di[r] = 0;
+    }
+
+    #pragma omp parallel
+    {
+        double      *acc = (double*) calloc(nreq, sizeof(double));
+        long        i;
+        unsigned    j, k;
+
+        /* Two-dimensional part, with stimulus means at (-1,-1) and (1,1) */
+        #pragma omp for schedule(static) nowait
+        for(i=0; i<(long)nodes; i++)
+            for(j=0; j<nodes; j++)
+            {
+                double  wnow = wx[i]*wx[j];
+                double  xa = x[i]+1, ya = x[j]+1, xb = x[i]-1, yb = x[j]-1;
+                double  sa = -0.5*(xa*xa+ya*ya), sb = -0.5*(xb*xb+yb*yb);
+                double  pa = xa*ya, pb = xb*yb;
+
+                #pragma omp simd
+                for(k=0; k<nreq; k++)
+                {
+                    double  lps1 = n1[k] + a1[k]*sa + c1[k]*pa;
+                    double  lps2 = n2[k] + a2[k]*sb + c2[k]*pb;
+                    double  lpi1 = l1[k] + tv[k]*sa;
+                    double  lpi2 = l2[k] + tv[k]*sb;
+                    double  ps1 = exp(lps1), ps2 = exp(lps2);
+                    double  px = ps1+ps2, pix = exp(lpi1)+exp(lpi2);
+                    double  val = ps1*(lps1-lpi1) + ps2*(lps2-lpi2) - px*log(px/pix);
+                    acc[k] += isfinite(val) ? wnow*val : 0;
+                }
+            }
+
+        /* One-dimensional part, where the first stimulus has probability 1-q */
+        #pragma omp for schedule(static) nowait
+        for(i=0; i<(long)nodes; i++)
+        {
+            double  xa = x[i]+1, xb = x[i]-1;
+            double  sa = -0.5*xa*xa, sb = -0.5*xb*xb;
+
+            #pragma omp simd
+            for(k=0; k<nreq; k++)
+            {
+                double  lps1 = l2[k] + sa - 0.5*log(2*M_PI);
+                double  lps2 = l1[k] + sb - 0.5*log(2*M_PI);
+                double  lpi1 = l2[k] + tv[k]*sa;
+                double  lpi2 = l1[k] + tv[k]*sb;
+                double  ps1 = exp(lps1), ps2 = exp(lps2);
+                double  px = ps1+ps2, pix = exp(lpi1)+exp(lpi2);
+                double  val = ps1*(lps1-lpi1) + ps2*(lps2-lpi2) - px*log(px/pix);
+                acc[k] += isfinite(val) ? wx[i]*val : 0;
+            }
+        }
+
+        #pragma omp critical
+        for(k=0; k<nreq; k++) di[k] += acc[k];
+        free(acc);
+    }
+    free(coef);
+}
+
+/* Class-conditional densities at the nodes for fixed correlation coefficients, which do not
+   depend on q. The first n2 nodes belong to the two-dimensional part and the rest to the
+   one-dimensional part. For each node, w is the weight, g1 and g2 the densities given each
+   stimulus and lg1 and lg2 their logarithms, and d = sb-sa, with sa and sb the exponents of
+   the NI likelihoods of each stimulus. */
+typedef struct
+{
+    unsigned    n, n2;
+    double      *w, *g1, *g2, *lg1, *lg2, *d;
+} batchCache;
+
+void batchCacheInit(batchCache *cache, double rho1, double rho2, unsigned nodes, const double *x, const double *wx)
+{
+    double      a1 = 1.0/(1.0-rho1*rho1);
+    double      a2 = 1.0/(1.0-rho2*rho2);
+    double      xa, ya, xb, yb, sa, sb;
+    unsigned    i, j, ind;
+
+    cache->n2  = nodes*nodes;
+    cache->n   = nodes*nodes+nodes;
+    cache->w   = (double*) mxMalloc(6*(size_t)cache->n*sizeof(double));
+    cache->g1  = cache->w   + cache->n;
+    cache->g2  = cache->g1  + cache->n;
+    cache->lg1 = cache->g2  + cache->n;
+    cache->lg2 = cache->lg1 + cache->n;
+    cache->d   = cache->lg2 + cache->n;
+
+    for(i=0; i<nodes; i++)
+        for(j=0; j<nodes; j++)
+        {
+            ind = i*nodes+j;
+            xa = x[i]+1; ya = x[j]+1; xb = x[i]-1; yb = x[j]-1;
+            cache->w[ind]   = wx[i]*wx[j];
+            sa              = -0.5*(xa*xa+ya*ya);
+            sb              = -0.5*(xb*xb+yb*yb);
+            cache->d[ind]   = sb-sa;
+            cache->lg1[ind] = 0.5*log(a1) - log(2*M_PI) + a1*sa + rho1*a1*xa*ya;
+            cache->lg2[ind] = 0.5*log(a2) - log(2*M_PI) + a2*sb + rho2*a2*xb*yb;
+        }
+    for(i=0; i<nodes; i++)
+    {
+        ind = cache->n2+i;
+        xa = x[i]+1; xb = x[i]-1;
+        cache->w[ind]   = wx[i];
+        cache->d[ind]   = 0.5*(xa*xa-xb*xb);
+        cache->lg1[ind] = -0.5*xa*xa - 0.5*log(2*M_PI);
+        cache->lg2[ind] = -0.5*xb*xb - 0.5*log(2*M_PI);
+    }
+    for(ind=0; ind<cache->n; ind++)
+    {
+        cache->g1[ind] = exp(cache->lg1[ind]);
+        cache->g2[ind] = exp(cache->lg2[ind]);
+    }
+}
+
+/* Same as batchLosses, but for requests that differ only in q (par[3*r]) and theta, with
+   the densities of the cache. With p1 = q1*g1, p2 = q2*g2 and px = p1+p2, the integrand
+   becomes p1*lg1 + p2*lg2 - px*log(px) + px*log(q1+q2*exp(theta*d)) - theta*d*p2, which
+   needs one exponential and two logarithms per node and request. In the one-dimensional
+   part, the probabilities of the stimuli are swapped. */
+void batchLossesCached(unsigned nreq, const double *par, const double *th, const batchCache *cache, double *di)
+{
+    double      *q = (double*) malloc(2*(size_t)nreq*sizeof(double));
+    double      *tv = q + nreq;
+    unsigned    r;
+
+    for(r=0; r<nreq; r++)
+    {
+        q[r]  = par[3*r];
+        tv[r] = th[r];
+        di[r] = 0;
+    }
+
+    #pragma omp parallel
+    {
+        double      *acc = (double*) calloc(nreq, sizeof(double));
+        long        i;
+        unsigned    k;
+
+        #pragma omp for schedule(static) nowait
+        for(i=0; i<(long)cache->n; i++)
+        {
+            double  w = cache->w[i], g1 = cache->g1[i], g2 = cache->g2[i];
+            double  lg1 = cache->lg1[i], lg2 = cache->lg2[i], d = cache->d[i];
+            int     swap = i>=(long)cache->n2;
+
+            #pragma omp simd
+            for(k=0; k<nreq; k++)
+            {
+                double  q1 = swap ? 1-q[k] : q[k];
+                double  q2 = 1-q1;
+                double  p1 = q1*g1, p2 = q2*g2, px = p1+p2;
+                double  val = p1*lg1 + p2*lg2 - px*log(px) + px*log(q1+q2*exp(tv[k]*d)) - tv[k]*d*p2;
+                acc[k] += isfinite(val) ? w*val : 0;
+            }
+        }
+
+        #pragma omp critical
+        for(k=0; k<nreq; k++) di[k] += acc[k];
+        free(acc);
+    }
+    free(q);
+}
+
+/* Information transmitted by both parts for each of the nq values of q, as given by
+   infoGauss([q,rho1,rho2])+infoGauss(1-q) */
+void batchInfoCached(unsigned nq, const double *qv, const batchCache *cache, double *info)
+{
+    unsigned    r;
+
+    for(r=0; r<nq; r++) info[r] = 0;
+
+    #pragma omp parallel
+    {
+        double      *acc = (double*) calloc(nq, sizeof(double));
+        long        i;
+        unsigned    k;
+
+        #pragma omp for schedule(static) nowait
+        for(i=0; i<(long)cache->n; i++)
+        {
+            double  w = cache->w[i], g1 = cache->g1[i], g2 = cache->g2[i];
+            double  lg1 = cache->lg1[i], lg2 = cache->lg2[i];
+            int     swap = i>=(long)cache->n2;
+
+            #pragma omp simd
+            for(k=0; k<nq; k++)
+            {
+                double  q1 = swap ? 1-qv[k] : qv[k];
+                double  p1 = q1*g1, p2 = (1-q1)*g2, px = p1+p2;
+                double  val = p1*lg1 + p2*lg2 - px*log(px);
+                acc[k] += isfinite(val) ? w*val : 0;
+            }
+        }
+
+        #pragma omp critical
+        for(k=0; k<nq; k++) info[k] += acc[k];
+        free(acc);
+    }
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    unsigned    nodes = 64;
+    unsigned    npt, nreq, nnew, ind, r, k;
+    double      *par, *di, *theta;
+    double      *x, *wx, *th, *rpar, *rdi, *qv = NULL;
+    unsigned    *owner, *first;
+    batchPoint  *pt;
+    batchCache  cache;
+
+    if(nrhs>1 && !mxIsEmpty(prhs[1])) nodes = (unsigned) mxGetScalar(prhs[1]);
+    if(nodes<2) mexErrMsgTxt("The number of nodes must be at least two");
+
+    if(nrhs>2)
+    {
+        /* Sweep over q with fixed correlation coefficients */
+        if(mxGetNumberOfElements(prhs[0])!=2) mexErrMsgTxt("Please specify the correlation coefficients as [rho1,rho2]");
+        npt = (unsigned) mxGetNumberOfElements(prhs[2]);
+        qv  = mxGetPr(prhs[2]);
+        par = (double*) mxMalloc(3*(npt+1)*sizeof(double));
+        for(ind=0; ind<npt; ind++)
+        {
+            par[ind]       = qv[ind];
+            par[ind+npt]   = mxGetPr(prhs[0])[0];
+            par[ind+2*npt] = mxGetPr(prhs[0])[1];
+        }
+    }
+    else
+    {
+        if(nrhs<1 || mxGetN(prhs[0])!=3) mexErrMsgTxt("Please specify the parameters as rows [q,rho1,rho2]");
+        npt = (unsigned) mxGetM(prhs[0]);
+        par = mxGetPr(prhs[0]);
+    }
+    plhs[0] = mxCreateDoubleMatrix(npt,1,mxREAL);
+    di = mxGetPr(plhs[0]);
+    if(nlhs>1)
+    {
+        plhs[1] = mxCreateDoubleMatrix(npt,1,mxREAL);
+        theta = mxGetPr(plhs[1]);
+    }
+    else
+        theta = NULL;
+    if(nlhs>2 && qv==NULL) mexErrMsgTxt("The information is only computed for sweeps over q");
+    if(npt==0) return;
+
+    x  = (double*) mxMalloc(2*nodes*sizeof(double));
+    wx = x + nodes;
+    gaussLegendre(nodes, -5, 5, x, wx);
+    if(qv!=NULL)
+    {
+        batchCacheInit(&cache, par[npt], par[2*npt], nodes, x, wx);
+        if(nlhs>2)
+        {
+            plhs[2] = mxCreateDoubleMatrix(npt,1,mxREAL);
+            batchInfoCached(npt, qv, &cache, mxGetPr(plhs[2]));
+        }
+    }
+
+    /* Each point issues at most three requests per round */
+    pt    = (batchPoint*) mxCalloc(npt, sizeof(batchPoint));
+    th    = (double*) mxMalloc(3*npt*sizeof(double));
+    rdi   = (double*) mxMalloc(3*npt*sizeof(double));
+    rpar  = (double*) mxMalloc(9*npt*sizeof(double));
+    owner = (unsigned*) mxMalloc(4*npt*sizeof(unsigned));
+    first = owner + 3*npt;
+
+    nreq = 0;
+    for(ind=0; ind<npt; ind++)
+    {
+        if(!(par[ind]>0 && par[ind]<1) || !(fabs(par[ind+npt])<1) || !(fabs(par[ind+2*npt])<1))
+            mexErrMsgTxt("The parameters must satisfy 0<q<1, |rho1|<1 and |rho2|<1");
+        pt[ind].phase = BATCH_PROBE;
+        pt[ind].thl = -0.5;
+        pt[ind].thm = 0.5;
+        pt[ind].thr = 1.5;
+        first[ind] = nreq;
+        for(k=0; k<3; k++)
+        {
+            th[nreq] = k==0 ? pt[ind].thl : (k==1 ? pt[ind].thm : pt[ind].thr);
+            owner[nreq++] = ind;
+        }
+    }
+
+    while(nreq>0)
+    {
+        for(r=0; r<nreq; r++)
+            for(k=0; k<3; k++) rpar[3*r+k] = par[owner[r]+k*npt];
+        if(qv!=NULL)
+            batchLossesCached(nreq, rpar, th, &cache, rdi);
+        else
+            batchLosses(nreq, rpar, th, nodes, x, wx, rdi);
+
+        /* Advancing the points in place. The requests of each point are contiguous, and
+           the new ones never outnumber the old ones. */
+        nnew = 0;
+        for(r=0; r<nreq; r++)
+        {
+            ind = owner[r];
+            if(first[ind]!=r) continue;
+            k = batchAdvance(pt+ind, rdi+r, th+nnew);
+            first[ind] = nnew;
+            while(k-->0) owner[nnew++] = ind;
+        }
+        nreq = nnew;
+    }
+
+    for(ind=0; ind<npt; ind++)
+    {
+        di[ind] = pt[ind].dim;
+        if(theta!=NULL) theta[ind] = pt[ind].thm;
+    }
+
+    mxFree(x);
+    mxFree(pt);
+    mxFree(th);
+    mxFree(rdi);
+    mxFree(rpar);
+    mxFree(owner);
+    if(qv!=NULL)
+    {
+        mxFree(cache.w);
+        mxFree(par);
+    }
+}
@@ -0,0 +1,325 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Computes the linear Fisher information of a population about a binary stimulus and its
+ counterpart for the NI decoder, as fast proxies for the information and the information
+ loss computed by the other mex-files (e.g., to decide in which regions of a parameter
+ space the latter are worth computing).
+
+ For stimuli s1 and s2 with means mu1 and mu2 and average covariance matrix
+ C = q*C1 + (1-q)*C2, with dmu = mu1 - mu2, the linear Fisher information is
+
+   fisher   = dmu' * inv(C) * dmu,
+
+ the linear Fisher information of the shuffled responses, or of a linear decoder that
+ ignores the noise correlations when applied to the shuffled responses, is
+
+   fishersh = dmu' * inv(D) * dmu,
+
+ where D is the diagonal of C, and the information extracted by the same decoder from the
+ actual responses is
+
+   fisherni = (dmu' * inv(D) * dmu)^2 / (dmu' * inv(D) * C * inv(D) * dmu).
+
+ The relative loss is dfisher = 1 - fisherni/fisher.
+
+ When computed from recorded responses, the plug-in estimates of fisher and fishersh are
+ biased. The bias is removed as in Kanitscheider et al. (2015), PLoS Comput Biol, 11(10),
+ e1004218, generalized to unequal numbers of trials per stimulus. The estimate of fisherni
+ is not corrected, and neither is dfisher.
+
+ USAGE:
+
+   res = dinidlGaussFisher(pops)
+   res = dinidlGaussFisher(r,s,subsets)
+
+ In the first form, pops is a struct array with fields q, mu1, mu2, C1 and C2 (as in
+ dinidlGaussPops.c), possibly with different numbers of neurons. In the second form, r is a
+ matrix with one row per trial and one column per neuron, s is a vector with the stimulus
+ of each trial (two different values, the first one in s being s1), and subsets is an
+ optional cell array whose elements are vectors with the neurons of each subset (default,
+ all neurons). The means and the covariance matrix of all neurons are estimated once and
+ shared among the subsets. The output res is a struct with fields fisher, fishersh,
+ fisherni and dfisher, each one with one value per population or subset. Populations and
+ subsets are distributed among the available cores.
+
+ This code uses the GNU Scientific Library (GSL), which can be downloaded from
+
+   http://www.gnu.org/software/gsl/
+
+ It should be installed wherever #include looks for headers, or
+ else, the folders in the #include statements within the c-files
+ (mex-files) should be modified.
+
+ The code can be compiled as follows
+
+   mex -v GCC='/usr/bin/gcc-4.7' CFLAGS='$CFLAGS -fopenmp' LDFLAGS='$LDFLAGS -fopenmp' -lgsl -lgslcblas -lm dinidlGaussFisher.c
+
+ where you should replace /usr/bin/gcc-4.7 for the appropriate folder
+ and C compiler compatible with your Matlab installation. The OpenMP flags are optional.
+
+ VERSION CONTROL
+
+ V1.000 (19 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#include<mex.h>
+#include<math.h>
+#include "gaussModel.h"
+
+/* Linear Fisher information of the neurons ind (or 0,...,d-1 if ind is NULL) given the
+   mean difference dmu and the average covariance matrix C of D neurons, stored row-major.
+   If nu > 0, fisher and fishersh are corrected for the bias of estimates obtained from n1
+   and n2 trials, with nu degrees of freedom of the covariance matrix. Returns 0 if the
+   covariance matrix is not positive definite. */
+int fisherLinear(const double *dmu, const double *C, unsigned D, const unsigned *ind, unsigned d,
+                 double nu, double n1, double n2, double res[4])
+{
+    double      *Cs = (double*) malloc(((size_t)2*d*d+2*d)*sizeof(double));
+    double      *L = Cs + (size_t)d*d;
+    double      *y = L + (size_t)d*d;
+    double      *w = y + d;
+    double      sum, full = 0, sh = 0, quad = 0, corr;
+    unsigned    i, j, k;
+
+    for(i=0; i<d; i++)
+        for(j=0; j<d; j++)
+            Cs[i*d+j] = C[(ind ? ind[i] : i)*D+(ind ? ind[j] : j)];
+    if(!choleskyDecomp(L, Cs, d)) { free(Cs); return 0; }
+
+    /* fisher = |inv(L)*dmu|^2 */
+    for(i=0; i<d; i++)
+    {
+        sum = dmu[ind ? ind[i] : i];
+        for(k=0; k<i; k++) sum -= L[i*d+k]*y[k];
+        y[i] = sum/L[i*d+i];
+        full += y[i]*y[i];
+    }
+
+    /* Decoder that ignores the noise correlations */
+    for(i=0; i<d; i++)
+    {
+        w[i] = dmu[ind ? ind[i] : i]/Cs[i*d+i];
+        sh  += w[i]*dmu[ind ? ind[i] : i];
+    }
+    for(i=0; i<d; i++)
+        for(j=0; j<d; j++) quad += w[i]*Cs[i*d+j]*w[j];
+
+    res[2] = sh*sh/quad;
+    res[3] = 1 - res[2]/full;
+    if(nu>0)
+    {
+        /* E[inv(Cest)] = nu/(nu-d-1)*inv(C) and E[dmuest*dmuest'] = dmu*dmu' + corr*C */
+        corr   = 1/n1 + 1/n2;
+        full   = full*(nu-d-1)/nu - d*corr;
+        sh     = sh*(nu-2)/nu - d*corr;
+        if(!(nu>d+1)) full = NAN;
+        if(!(nu>2))   sh   = NAN;
+    }
+    res[0] = full;
+    res[1] = sh;
+    free(Cs);
+    return 1;
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    const char  *fields[4] = {"fisher","fishersh","fisherni","dfisher"};
+    double      *out[4];
+    unsigned    num, f;
+    long        ind;
+    int         failed = 0;
+
+    if(nrhs<1) mexErrMsgTxt("Please specify the populations or the responses and the stimuli");
+
+    if(mxIsStruct(prhs[0]))
+    {
+        gaussModel  **pop;
+
+        num = (unsigned) mxGetNumberOfElements(prhs[0]);
+        pop = (gaussModel**) mxMalloc(num*sizeof(gaussModel*));
+        for(ind=0; ind<num; ind++) pop[ind] = gaussModelFromStruct(prhs[0], ind);
+
+        plhs[0] = mxCreateStructMatrix(1,1,4,fields);
+        for(f=0; f<4; f++)
+        {
+            mxSetField(plhs[0],0,fields[f],mxCreateDoubleMatrix(1,num,mxREAL));
+            out[f] = mxGetPr(mxGetField(plhs[0],0,fields[f]));
+        }
+
+        #pragma omp parallel for schedule(dynamic)
+        for(ind=0; ind<(long)num; ind++)
+        {
+            unsigned    d = pop[ind]->d, i, j, ff;
+            double      *dmu = (double*) malloc(((size_t)d*d+d)*sizeof(double));
+            double      *C = dmu + d;
+            double      res[4];
+
+            for(i=0; i<d; i++)
+            {
+                dmu[i] = pop[ind]->mu[0][i] - pop[ind]->mu[1][i];
+                for(j=0; j<d; j++)
+                    C[i*d+j] = pop[ind]->q*pop[ind]->C[0][i*d+j] + (1-pop[ind]->q)*pop[ind]->C[1][i*d+j];
+            }
+            fisherLinear(dmu, C, d, NULL, d, 0, 0, 0, res);
+            for(ff=0; ff<4; ff++) out[ff][ind] = res[ff];
+            free(dmu);
+        }
+
+        for(ind=0; ind<num; ind++) gaussModelFree(pop[ind]);
+        mxFree(pop);
+        return;
+    }
+
+    {
+        unsigned    D, **sub, *nsub;
+        size_t      n, t, cnt[2] = {0,0};
+        double      *r, *s, *dmu, *mu, *C, label = 0, nu;
+        unsigned    *cls;
+        long        i;
+
+        if(nrhs<2) mexErrMsgTxt("Please specify the responses and the stimuli");
+        n = mxGetM(prhs[0]);
+        D = (unsigned) mxGetN(prhs[0]);
+        r = mxGetPr(prhs[0]);
+        s = mxGetPr(prhs[1]);
+        if(mxGetNumberOfElements(prhs[1])!=n) mexErrMsgTxt("Please specify one stimulus per trial");
+        if(n==0 || D==0) mexErrMsgTxt("Please specify at least one trial and one neuron");
+
+        /* Stimulus of each trial, 0 for the first value in s and 1 for the other */
+        cls = (unsigned*) mxMalloc(n*sizeof(unsigned));
+        for(t=0; t<n; t++)
+        {
+            if(s[t]!=s[0] && cnt[1]>0 && s[t]!=label) mexErrMsgTxt("The stimuli must take two values");
+            if(s[t]!=s[0]) label = s[t];
+            cls[t] = s[t]!=s[0];
+            cnt[s[t]!=s[0]]++;
+        }
+        if(cnt[1]==0) mexErrMsgTxt("The stimuli must take two values");
+        nu = (double)n-2;
+
+        /* Means and pooled covariance matrix of all neurons */
+        mu  = (double*) mxCalloc(3*(size_t)D+(size_t)D*D, sizeof(double));
+        dmu = mu + 2*(size_t)D;
+        C   = dmu + D;
+        for(t=0; t<n; t++)
+            for(i=0; i<(long)D; i++) mu[cls[t]*D+i] += r[t+n*i]/cnt[cls[t]];
+        for(i=0; i<(long)D; i++) dmu[i] = mu[i] - mu[D+i];
+
+        #pragma omp parallel for schedule(dynamic)
+        for(i=0; i<(long)D; i++)
+        {
+            unsigned    j;
+            size_t      tt;
+            double      sum;
+
+            for(j=0; j<=(unsigned)i; j++)
+            {
+                sum = 0;
+                for(tt=0; tt<n; tt++)
+                    sum += (r[tt+n*i]-mu[cls[tt]*D+i])*(r[tt+n*j]-mu[cls[tt]*D+j]);
+                C[i*D+j] = C[j*D+i] = sum/nu;
+            }
+        }
+
+        /* Subsets of neurons */
+        num  = nrhs>2 && !mxIsEmpty(prhs[2]) ? (unsigned) mxGetNumberOfElements(prhs[2]) : 1;
+        sub  = (unsigned**) mxMalloc(num*sizeof(unsigned*));
+        nsub = (unsigned*) mxMalloc(num*sizeof(unsigned));
+        for(ind=0; ind<num; ind++)
+        {
+            const mxArray   *cell;
+            double          *val;
+            unsigned        k;
+
+            if(nrhs>2 && !mxIsEmpty(prhs[2]))
+            {
+                if(!mxIsCell(prhs[2])) mexErrMsgTxt("The subsets must be given as a cell array");
+                cell = mxGetCell(prhs[2], ind);
+                if(cell==NULL || mxIsEmpty(cell)) mexErrMsgTxt("The subsets must not be empty");
+                nsub[ind] = (unsigned) mxGetNumberOfElements(cell);
+                val = mxGetPr(cell);
+                sub[ind] = (unsigned*) mxMalloc(nsub[ind]*sizeof(unsigned));
+                for(k=0; k<nsub[ind]; k++)
+                {
+                    if(!(val[k]>=1 && val[k]<=D)) mexErrMsgTxt("The subsets must contain neurons between one and the number of neurons");
+                    sub[ind][k] = (unsigned) val[k]-1;
+                }
+            }
+            else
+            {
+                nsub[ind] = D;
+                sub[ind]  = NULL;
+            }
+        }
+
+        plhs[0] = mxCreateStructMatrix(1,1,4,fields);
+        for(f=0; f<4; f++)
+        {
+            mxSetField(plhs[0],0,fields[f],mxCreateDoubleMatrix(1,num,mxREAL));
+            out[f] = mxGetPr(mxGetField(plhs[0],0,fields[f]));
+        }
+
+        #pragma omp parallel for schedule(dynamic)
+        for(ind=0; ind<(long)num; ind++)
+        {
+            double      res[4];
+            unsigned    ff;
+
+            if(!fisherLinear(dmu, C, D, sub[ind], nsub[ind], nu, (double)cnt[0], (double)cnt[1], res))
+            {
+                #pragma omp atomic write
+                failed = 1;
+                continue;
+            }
+            for(ff=0; ff<4; ff++) out[ff][ind] = res[ff];
+        }
+
+        for(ind=0; ind<num; ind++) if(sub[ind]) mxFree(sub[ind]);
+        mxFree(sub);
+        mxFree(nsub);
+        mxFree(mu);
+        mxFree(cls);
+    }
+    if(failed) mexErrMsgTxt("The estimated covariance matrices must be positive definite");
+}
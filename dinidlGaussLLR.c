@@ -0,0 +1,126 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Computes the transmitted information and the descriptive and communication information
+ losses caused by NI decoders for a population of any number of neurons whose responses
+ to two stimuli have arbitrary Gaussian distributions.
+
+ Instead of integrating over the responses, as done in dinidlGaussTheta, the computation
+ integrates over the pair of log-likelihood ratios (lam,ell) of the true and NI decoders,
+ which are quadratic forms of the responses. Their joint distribution given each stimulus
+ is obtained by inverting their characteristic function, which has a closed form, with an
+ FFT (see gaussModel.h). The final integral is therefore two-dimensional regardless of
+ the number of neurons, and the cost grows only polynomially with it, through one
+ eigendecomposition per frequency.
+
+ USAGE:
+
+   [di,did,info,theta] = dinidlGaussLLR(pop,bins)
+
+ where pop is a struct with fields q (probability of the first stimulus), mu1 and mu2
+ (mean responses to each stimulus), and C1 and C2 (covariance matrices of the responses to
+ each stimulus), and bins is the number of grid bins along each log-likelihood ratio (a
+ power of two, default 512). The outputs are the communication information loss, the
+ descriptive information loss, the transmitted information and the value of theta
+ minimizing the information loss. For example, the first population in Figure 4 is
+
+   pop = struct('q',q,'mu1',[-1,-1],'mu2',[1,1],'C1',[1,rho;rho,1],'C2',[1,rho;rho,1]);
+
+ The code requires the following library
+
+ - GSL (https://www.gnu.org/software/gsl/)
+
+ It should be installed wherever #include looks for headers, or
+ else, the folders in the #include statements within the c-files
+ (mex-files) should be modified.
+
+ The code can be compiled as follows
+
+   mex -v GCC='/usr/bin/gcc-4.7' CFLAGS='$CFLAGS -fopenmp' LDFLAGS='$LDFLAGS -fopenmp' -lgsl -lgslcblas -lm dinidlGaussLLR.c
+
+ where you should replace /usr/bin/gcc-4.7 for the appropriate folder
+ and C compiler compatible with your Matlab installation. The OpenMP flags are optional
+ and distribute the frequencies among the available cores.
+
+ VERSION CONTROL
+
+ V1.000 (18 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#include<mex.h>
+#include<math.h>
+#include "gaussModel.h"
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    unsigned    bins = 512;
+    double      th;
+    double      di, did, info;
+    gaussModel  *pop;
+    llrGrid     *grid;
+    llrTable    *tab;
+    llrDIPar    dipar;
+
+    if(nrhs<1) mexErrMsgTxt("Please specify the population");
+    if(nrhs>1 && !mxIsEmpty(prhs[1])) bins = (unsigned) mxGetScalar(prhs[1]);
+    if(bins<8 || (bins&(bins-1))) mexErrMsgTxt("The number of bins must be a power of two");
+
+    pop  = gaussModelFromStruct(prhs[0], 0);
+    grid = gaussModelGrid(pop, bins);
+    tab  = llrGridToTable(grid, 0);
+
+    info = llrInfo(tab, pop->q);
+    did  = llrDI(tab, pop->q, 1);
+    dipar.tab = tab;
+    dipar.q   = pop->q;
+    di = llrMinimize(llrDITheta, &dipar, &th);
+
+    plhs[0] = mxCreateDoubleScalar(di);
+    if(nlhs>1) plhs[1] = mxCreateDoubleScalar(did);
+    if(nlhs>2) plhs[2] = mxCreateDoubleScalar(info);
+    if(nlhs>3) plhs[3] = mxCreateDoubleScalar(th);
+
+    llrTableFree(tab);
+    llrGridFree(grid);
+    gaussModelFree(pop);
+}
@@ -0,0 +1,379 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Computes the information transmitted and the communication information losses caused by
+ NI decoders for every subset of a given set of populations with Gaussian responses, all
+ of which encode the same binary stimulus and are conditionally independent given the
+ stimulus. This shows how the losses change as populations are added to the decoder.
+
+ For M populations, there are 2^M-1 subsets. Instead of computing each of them from
+ scratch, the characteristic functions of the true and NI log-likelihood ratios of each
+ population (see gaussModel.h) are computed only once, at frequencies shared by all
+ subsets. Because the log-likelihood ratios of conditionally independent populations add,
+ the characteristic function of each subset is the product of that of its parent subset
+ (the subset without its last population) and that of the added population. The lattice
+ of subsets is traversed in depth-first order, keeping the products of the parent subsets
+ in a stack, and its branches are distributed among the available cores. Each subset then
+ requires only one inverse FFT and the corresponding table (see llrTable.h).
+
+ USAGE:
+
+   res = dinidlGaussLattice(pops,bins)
+
+ where pops is a struct array with one element per population and fields q, mu1, mu2, C1 and
+ C2 (see dinidlGaussLLR.c), with the same value of q for all populations, and bins is the
+ number of grid bins along each log-likelihood ratio (a power of two, default 512). The
+ grid spacings are shared by the subsets: the coarsest one covers all populations, and
+ each subset uses the finest of up to four spacings, each half the previous one, that
+ covers it. Thus, the number of bins should grow with the number of populations. The
+ output res is a struct with fields
+
+   members  logical matrix whose column k indicates the populations in subset k, namely,
+            those corresponding to the bits of k (members(m,k) = bitget(k,m))
+   di       communication information loss of each subset
+   did      descriptive information loss of each subset
+   info     information transmitted by each subset
+   theta    value of theta minimizing the loss of each subset
+
+ Memory: each grid holds 4*bins^2 doubles (8 MB for 512 bins). The characteristic
+ functions of the populations take up to 4*npop grids, shared by all threads. In addition,
+ each thread keeps one stack of grids, reused by all the branches it explores, with up to
+ four grids per population below the highest six plus four for the root of the branch and
+ one for the inverse FFT. The grids are only allocated as the traversal reaches them, so
+ that subsets covered by coarser spacings use fewer of them. For 20 populations and 512
+ bins, a stack may take up to 61 grids (about 490 MB). Where the system reports its
+ available memory, the number of threads is reduced so that the stacks fit in it.
+
+ The code requires the following library
+
+ - GSL (https://www.gnu.org/software/gsl/)
+
+ It should be installed wherever #include looks for headers, or
+ else, the folders in the #include statements within the c-files
+ (mex-files) should be modified.
+
+ The code can be compiled as follows
+
+   mex -v GCC='/usr/bin/gcc-4.7' CFLAGS='$CFLAGS -fopenmp' LDFLAGS='$LDFLAGS -fopenmp' -lgsl -lgslcblas -lm dinidlGaussLattice.c
+
+ where you should replace /usr/bin/gcc-4.7 for the appropriate folder
+ and C compiler compatible with your Matlab installation. The OpenMP flags are optional
+ and distribute the branches of the lattice among the available cores.
+
+ VERSION CONTROL
+
+ V1.000 (18 Oct 2026)
+ V1.001 Reuses one stack per thread and caps the threads by memory (19 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#include<mex.h>
+#include<math.h>
+#include<string.h>
+#ifdef _OPENMP
+#include<omp.h>
+#endif
+#ifdef __unix__
+#include<unistd.h>
+#endif
+#include "gaussModel.h"
+
+/* Maximum number of populations, limited by the number of subsets */
+#define LATTICE_MAXPOP 20
+
+/* The lowest populations are traversed depth-first within each branch, whereas the highest
+   LATTICE_HIGHPOP populations define the branches, which are distributed among the cores */
+#define LATTICE_HIGHPOP 6
+
+/* Number of grid spacings, each half the previous one, available to the subsets */
+#define LATTICE_LEVELS 4
+
+typedef struct
+{
+    unsigned    npop;
+    unsigned    bins;
+    unsigned    nlev;
+    double      q;
+    double      h[2];
+    double      (*mean)[2][2];
+    double      (*var)[2][2];
+    llrGrid     **cf;
+    double      *di, *did, *info, *theta;
+} latticePar;
+
+/* Upper bound of the width of the window of the subset mask along each log-likelihood ratio
+   (see gaussModelWindow), which grows as populations are added to the subset */
+void latticeWidth(const latticePar *par, unsigned mask, double width[2])
+{
+    unsigned    m, f;
+    double      dmean, vmax;
+
+    for(f=0; f<2; f++)
+    {
+        dmean = vmax = 0;
+        for(m=0; m<par->npop; m++)
+            if(mask>>m&1)
+            {
+                dmean += fabs(par->mean[m][0][f]-par->mean[m][1][f]);
+                vmax  += par->var[m][0][f]>par->var[m][1][f] ? par->var[m][0][f] : par->var[m][1][f];
+            }
+        width[f] = dmean+32*sqrt(vmax);
+    }
+}
+
+/* Finest level whose grid spacing, par->h divided by 2^level, covers the subset mask */
+unsigned latticeLevel(const latticePar *par, unsigned mask)
+{
+    unsigned    level = par->nlev-1;
+    double      width[2];
+
+    latticeWidth(par, mask, width);
+    while(level>0 && (width[0]>(par->bins-1)*ldexp(par->h[0],-(int)level)
+                   || width[1]>(par->bins-1)*ldexp(par->h[1],-(int)level))) level--;
+    return level;
+}
+
+/* Number of threads whose stacks, each of up to ngrid grids, fit in the available memory */
+int latticeThreads(unsigned bins, unsigned ngrid)
+{
+    int         nthreads = 1;
+    double      need = 4*sizeof(double)*(double)bins*bins*ngrid;
+
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+#ifdef _SC_AVPHYS_PAGES
+    {
+        double  avail = (double)sysconf(_SC_AVPHYS_PAGES)*sysconf(_SC_PAGESIZE);
+
+        if(avail>0 && nthreads*need>avail) nthreads = avail>=2*need ? (int)(avail/need) : 1;
+    }
+#endif
+    return nthreads;
+}
+
+/* Losses of the subset mask, whose characteristic functions at the given level are given
+   by spec */
+void latticeSubset(const latticePar *par, const llrGrid *spec, llrGrid *work, unsigned mask, unsigned level)
+{
+    unsigned    m, s, f;
+    size_t      num = 2*(size_t)par->bins*par->bins;
+    double      mean[2][2] = {{0,0},{0,0}}, var[2][2] = {{0,0},{0,0}};
+    llrTable    *tab;
+    llrDIPar    popdi;
+
+    for(m=0; m<par->npop; m++)
+        if(mask>>m&1)
+            for(s=0; s<2; s++)
+                for(f=0; f<2; f++)
+                {
+                    mean[s][f] += par->mean[m][s][f];
+                    var[s][f]  += par->var[m][s][f];
+                }
+
+    /* The origin of the window follows the subset, but the spacing is that of the level */
+    gaussModelWindow(work, mean, var);
+    work->h[0] = ldexp(par->h[0],-(int)level);
+    work->h[1] = ldexp(par->h[1],-(int)level);
+    memcpy(work->val[0], spec->val[0], num*sizeof(double));
+    memcpy(work->val[1], spec->val[1], num*sizeof(double));
+    gaussModelCFInvert(work);
+    tab = llrGridToTable(work, 0);
+
+    par->info[mask-1] = llrInfo(tab, par->q);
+    par->did[mask-1]  = llrDI(tab, par->q, 1);
+    popdi.tab = tab;
+    popdi.q   = par->q;
+    par->di[mask-1]   = llrMinimize(llrDITheta, &popdi, par->theta+mask-1);
+    llrTableFree(tab);
+}
+
+/* Depth-first traversal of the subsets obtained by adding to mask populations below m.
+   Here, stack[depth*LATTICE_LEVELS+level] holds the characteristic functions of mask at
+   each level up to that of mask, which bounds the levels of the subsets below. The grids
+   of the stack are allocated the first time they are reached, and reused afterwards. */
+void latticeBranch(const latticePar *par, llrGrid **stack, unsigned depth, llrGrid *work, unsigned mask, unsigned m)
+{
+    unsigned    ind, child, level, lev;
+    size_t      num = 2*(size_t)par->bins*par->bins;
+    llrGrid     **now  = stack+depth*LATTICE_LEVELS;
+    llrGrid     **next = now+LATTICE_LEVELS;
+
+    for(ind=0; ind<m; ind++)
+    {
+        child = mask|1u<<ind;
+        level = latticeLevel(par, child);
+        for(lev=0; lev<=level; lev++)
+        {
+            if(next[lev]==NULL) next[lev] = llrGridAlloc(par->bins,par->bins);
+            memcpy(next[lev]->val[0], now[lev]->val[0], num*sizeof(double));
+            memcpy(next[lev]->val[1], now[lev]->val[1], num*sizeof(double));
+            llrGridMulPow(next[lev], par->cf[ind*LATTICE_LEVELS+lev], 1);
+        }
+        latticeSubset(par, next[level], work, child, level);
+        latticeBranch(par, stack, depth+1, work, child, ind);
+    }
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    const char  *fields[5] = {"members","di","did","info","theta"};
+    unsigned    bins = 512;
+    unsigned    npop, nlow, nsub, m, s, f, lev, maxlev;
+    int         nthreads;
+    long        high;
+    double      width[2];
+    mxLogical   *members;
+    gaussModel  **pop;
+    latticePar  par;
+
+    if(nrhs<1) mexErrMsgTxt("Please specify the populations");
+    if(nrhs>1 && !mxIsEmpty(prhs[1])) bins = (unsigned) mxGetScalar(prhs[1]);
+    if(bins<8 || (bins&(bins-1))) mexErrMsgTxt("The number of bins must be a power of two");
+
+    npop = (unsigned) mxGetNumberOfElements(prhs[0]);
+    if(npop==0) mexErrMsgTxt("Please specify at least one population");
+    if(npop>LATTICE_MAXPOP) mexErrMsgTxt("Too many populations");
+    nsub = (1u<<npop)-1;
+    nlow = npop>LATTICE_HIGHPOP ? npop-LATTICE_HIGHPOP : 0;
+
+    plhs[0] = mxCreateStructMatrix(1,1,5,fields);
+    mxSetField(plhs[0],0,"members",mxCreateLogicalMatrix(npop,nsub));
+    mxSetField(plhs[0],0,"di",   mxCreateDoubleMatrix(1,nsub,mxREAL));
+    mxSetField(plhs[0],0,"did",  mxCreateDoubleMatrix(1,nsub,mxREAL));
+    mxSetField(plhs[0],0,"info", mxCreateDoubleMatrix(1,nsub,mxREAL));
+    mxSetField(plhs[0],0,"theta",mxCreateDoubleMatrix(1,nsub,mxREAL));
+    members   = mxGetLogicals(mxGetField(plhs[0],0,"members"));
+    par.di    = mxGetPr(mxGetField(plhs[0],0,"di"));
+    par.did   = mxGetPr(mxGetField(plhs[0],0,"did"));
+    par.info  = mxGetPr(mxGetField(plhs[0],0,"info"));
+    par.theta = mxGetPr(mxGetField(plhs[0],0,"theta"));
+    for(high=0; high<nsub; high++)
+        for(m=0; m<npop; m++)
+            members[(size_t)high*npop+m] = (mxLogical)((high+1)>>m&1);
+
+    /* The Matlab API is not thread safe, so the populations are read beforehand */
+    pop      = (gaussModel**) mxMalloc(npop*sizeof(gaussModel*));
+    par.cf   = (llrGrid**) mxCalloc(npop*LATTICE_LEVELS, sizeof(llrGrid*));
+    par.mean = (double(*)[2][2]) mxMalloc(npop*sizeof(double[2][2]));
+    par.var  = (double(*)[2][2]) mxMalloc(npop*sizeof(double[2][2]));
+    for(m=0; m<npop; m++)
+    {
+        pop[m] = gaussModelFromStruct(prhs[0], m);
+        if(pop[m]->q!=pop[0]->q) mexErrMsgTxt("All populations must have the same value of q");
+        for(s=0; s<2; s++)
+            for(f=0; f<2; f++)
+                gaussModelMoments(pop[m], s, f, &par.mean[m][s][f], &par.var[m][s][f]);
+    }
+    par.npop = npop;
+    par.bins = bins;
+    par.nlev = LATTICE_LEVELS;
+    par.q    = pop[0]->q;
+
+    /* The coarsest spacing covers the windows of all subsets. It is the same for both
+       log-likelihood ratios, so that populations with lam = ell (e.g., single neurons)
+       fall on the diagonal of the grid */
+    latticeWidth(&par, nsub, width);
+    if(width[1]>width[0]) width[0] = width[1];
+    par.h[0] = par.h[1] = (width[0]>1E-6 ? width[0] : 1.0)/(bins-1);
+
+    /* Characteristic functions of each population at the frequencies of each level, up to
+       the finest level used by the subsets containing it */
+    for(m=0; m<npop; m++)
+        for(lev=0; lev<=latticeLevel(&par, 1u<<m); lev++)
+        {
+            par.cf[m*LATTICE_LEVELS+lev] = llrGridAlloc(bins,bins);
+            par.cf[m*LATTICE_LEVELS+lev]->h[0] = ldexp(par.h[0],-(int)lev);
+            par.cf[m*LATTICE_LEVELS+lev]->h[1] = ldexp(par.h[1],-(int)lev);
+            gaussModelCFOne(par.cf[m*LATTICE_LEVELS+lev]);
+            gaussModelCFGrid(pop[m], par.cf[m*LATTICE_LEVELS+lev], 1);
+        }
+
+    /* Each branch fixes the populations above nlow and explores those below. Every subset
+       below the root of a branch contains some population, so it uses at most maxlev+1
+       levels, and each thread reuses a single stack for all its branches */
+    maxlev = 0;
+    for(m=0; m<npop; m++)
+        if(latticeLevel(&par, 1u<<m)>maxlev) maxlev = latticeLevel(&par, 1u<<m);
+    nthreads = latticeThreads(bins, LATTICE_LEVELS+nlow*(maxlev+1)+1);
+
+    #pragma omp parallel num_threads(nthreads)
+    {
+        llrGrid     *stack[(LATTICE_MAXPOP+1)*LATTICE_LEVELS];
+        llrGrid     *work = llrGridAlloc(bins,bins);
+        unsigned    mask, level, ind, lev;
+
+        memset(stack, 0, sizeof(stack));
+
+        #pragma omp for schedule(dynamic)
+        for(high=(1L<<(npop-nlow))-1; high>=0; high--)
+        {
+            mask  = (unsigned)high<<nlow;
+            level = latticeLevel(&par, mask);
+            for(lev=0; lev<=level; lev++)
+            {
+                if(stack[lev]==NULL) stack[lev] = llrGridAlloc(bins,bins);
+                gaussModelCFOne(stack[lev]);
+                for(ind=nlow; ind<npop; ind++)
+                    if(mask>>ind&1)
+                        llrGridMulPow(stack[lev], par.cf[ind*LATTICE_LEVELS+lev], 1);
+            }
+
+            if(mask) latticeSubset(&par, stack[level], work, mask, level);
+            latticeBranch(&par, stack, 0, work, mask, nlow);
+        }
+
+        for(ind=0; ind<(nlow+1)*LATTICE_LEVELS; ind++) llrGridFree(stack[ind]);
+        llrGridFree(work);
+    }
+
+    for(m=0; m<npop; m++)
+    {
+        for(lev=0; lev<LATTICE_LEVELS; lev++)
+            if(par.cf[m*LATTICE_LEVELS+lev]!=NULL) llrGridFree(par.cf[m*LATTICE_LEVELS+lev]);
+        gaussModelFree(pop[m]);
+    }
+    mxFree(pop);
+    mxFree(par.cf);
+    mxFree(par.mean);
+    mxFree(par.var);
+}
@@ -0,0 +1,251 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Computes, for any number of populations with arbitrary Gaussian responses to a binary
+ stimulus, a family of measures of the role of noise correlations, sharing the costly part
+ of the computation among them. The measures are
+
+ - the transmitted information I,
+ - the descriptive information loss caused by the NI decoder with theta=1, which coincides
+   with the measure DeltaI introduced by Nirenberg and Latham,
+ - the communication information loss, minimized over theta, which coincides with the
+   measure DeltaI* of Latham and Nirenberg (the difference between I and the information
+   lower bound attained by mismatched decoders),
+ - the measure DeltaI_LS, taken here as the decrease in the information about the stimulus
+   carried by its maximum a posteriori estimate when the NI posterior pNI(s|r) replaces the
+   true posterior p(s|r),
+ - the information loss of the NI decoder for any given list of values of theta,
+ - the information Ish transmitted by the shuffled responses, in which the neurons are
+   conditionally independent but keep their marginal distributions, and the difference
+   DeltaIsh = I - Ish,
+ - the sum Iind of the information transmitted by each neuron alone, and the synergy
+   I - Iind.
+
+ The first five measures depend on the responses only through the true and NI
+ log-likelihood ratios (lam,ell), so they are read off a single table of their joint
+ distribution (see dinidlGaussLLR.c) in a single pass in which the terms of the true
+ posterior are shared (see llrTable.h). Only the minimization over theta requires further
+ passes. The other measures involve other distributions of the responses, but the same
+ machinery: for the shuffled responses and for single neurons, the true and NI
+ log-likelihood ratios coincide, and their tables are obtained in the same way.
+
+ USAGE:
+
+   res = dinidlGaussMeasures(pops,bins,thetas)
+
+ where pops is a struct array with one element per population and fields q, mu1, mu2, C1 and
+ C2 (see dinidlGaussLLR.c), bins is the number of grid bins along each log-likelihood ratio
+ (a power of two, default 512), and thetas is a vector of values of theta (default empty).
+ The output res is a struct with fields containing one column per population:
+
+   info        information transmitted by the population
+   did         descriptive information loss (theta=1)
+   di          communication information loss
+   theta       value of theta minimizing the loss
+   dils        DeltaI_LS
+   dicurve     information loss caused by the NI decoder with each value in thetas
+   infosh      information transmitted by the shuffled responses
+   dish        info - infosh
+   infoind     sum of the information transmitted by each neuron alone
+   syn         synergy, info - infoind
+   infosingle  cell array with the information transmitted by each neuron alone
+
+ The code requires the following library
+
+ - GSL (https://www.gnu.org/software/gsl/)
+
+ It should be installed wherever #include looks for headers, or
+ else, the folders in the #include statements within the c-files
+ (mex-files) should be modified.
+
+ The code can be compiled as follows
+
+   mex -v GCC='/usr/bin/gcc-4.7' CFLAGS='$CFLAGS -fopenmp' LDFLAGS='$LDFLAGS -fopenmp' -lgsl -lgslcblas -lm dinidlGaussMeasures.c
+
+ where you should replace /usr/bin/gcc-4.7 for the appropriate folder
+ and C compiler compatible with your Matlab installation. The OpenMP flags are optional
+ and distribute the populations among the available cores.
+
+ VERSION CONTROL
+
+ V1.000 (19 Oct 2026)
+ V1.001 DeltaI_LS read off the same pass (19 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#include<mex.h>
+#include<math.h>
+#include "gaussModel.h"
+
+/* Information transmitted by the population pop with its covariance matrices replaced by
+   their diagonals, or by the neuron ind alone if ind < pop->d. In both cases, lam = ell. */
+double measuresInfoNI(const gaussModel *pop, unsigned bins, unsigned ind)
+{
+    unsigned    d = pop->d;
+    unsigned    dnow = ind<d ? 1 : d;
+    unsigned    s, i;
+    double      info;
+    gaussModel  *sub = gaussModelAlloc(dnow);
+    llrGrid     *grid;
+    llrTable    *tab;
+
+    sub->q = pop->q;
+    for(s=0; s<2; s++)
+        for(i=0; i<dnow; i++)
+        {
+            sub->mu[s][i] = pop->mu[s][ind<d ? ind : i];
+            sub->C[s][i*dnow+i] = pop->C[s][(ind<d ? ind : i)*(d+1)];
+        }
+    gaussModelInit(sub);
+
+    grid = gaussModelGrid(sub, bins);
+    tab  = llrGridToTable(grid, 0);
+    info = llrInfo(tab, sub->q);
+
+    llrTableFree(tab);
+    llrGridFree(grid);
+    gaussModelFree(sub);
+    return info;
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    const char  *fields[11] = {"info","did","di","theta","dils","dicurve","infosh","dish","infoind",
+                               "syn","infosingle"};
+    unsigned    bins = 512;
+    unsigned    npop, nth = 0;
+    long        indp;
+    double      *thetas = NULL;
+    double      *info, *did, *di, *theta, *dils, *dicurve, *infosh, *dish, *infoind, *syn;
+    double      **single;
+    mxArray     *cell;
+    gaussModel  **pop;
+
+    if(nrhs<1) mexErrMsgTxt("Please specify the populations");
+    if(nrhs>1 && !mxIsEmpty(prhs[1])) bins = (unsigned) mxGetScalar(prhs[1]);
+    if(bins<8 || (bins&(bins-1))) mexErrMsgTxt("The number of bins must be a power of two");
+    if(nrhs>2 && !mxIsEmpty(prhs[2]))
+    {
+        nth    = (unsigned) mxGetNumberOfElements(prhs[2]);
+        thetas = mxGetPr(prhs[2]);
+    }
+
+    npop = (unsigned) mxGetNumberOfElements(prhs[0]);
+    if(npop==0) mexErrMsgTxt("Please specify at least one population");
+
+    plhs[0] = mxCreateStructMatrix(1,1,11,fields);
+    mxSetField(plhs[0],0,"info",   mxCreateDoubleMatrix(1,npop,mxREAL));
+    mxSetField(plhs[0],0,"did",    mxCreateDoubleMatrix(1,npop,mxREAL));
+    mxSetField(plhs[0],0,"di",     mxCreateDoubleMatrix(1,npop,mxREAL));
+    mxSetField(plhs[0],0,"theta",  mxCreateDoubleMatrix(1,npop,mxREAL));
+    mxSetField(plhs[0],0,"dils",   mxCreateDoubleMatrix(1,npop,mxREAL));
+    mxSetField(plhs[0],0,"dicurve",mxCreateDoubleMatrix(nth,npop,mxREAL));
+    mxSetField(plhs[0],0,"infosh", mxCreateDoubleMatrix(1,npop,mxREAL));
+    mxSetField(plhs[0],0,"dish",   mxCreateDoubleMatrix(1,npop,mxREAL));
+    mxSetField(plhs[0],0,"infoind",mxCreateDoubleMatrix(1,npop,mxREAL));
+    mxSetField(plhs[0],0,"syn",    mxCreateDoubleMatrix(1,npop,mxREAL));
+    info    = mxGetPr(mxGetField(plhs[0],0,"info"));
+    did     = mxGetPr(mxGetField(plhs[0],0,"did"));
+    di      = mxGetPr(mxGetField(plhs[0],0,"di"));
+    theta   = mxGetPr(mxGetField(plhs[0],0,"theta"));
+    dils    = mxGetPr(mxGetField(plhs[0],0,"dils"));
+    dicurve = mxGetPr(mxGetField(plhs[0],0,"dicurve"));
+    infosh  = mxGetPr(mxGetField(plhs[0],0,"infosh"));
+    dish    = mxGetPr(mxGetField(plhs[0],0,"dish"));
+    infoind = mxGetPr(mxGetField(plhs[0],0,"infoind"));
+    syn     = mxGetPr(mxGetField(plhs[0],0,"syn"));
+
+    /* The Matlab API is not thread safe, so the populations and outputs are created
+       beforehand */
+    pop    = (gaussModel**) mxMalloc(npop*sizeof(gaussModel*));
+    single = (double**) mxMalloc(npop*sizeof(double*));
+    cell   = mxCreateCellMatrix(1,npop);
+    for(indp=0; indp<npop; indp++)
+    {
+        pop[indp] = gaussModelFromStruct(prhs[0], indp);
+        mxSetCell(cell, indp, mxCreateDoubleMatrix(1,pop[indp]->d,mxREAL));
+        single[indp] = mxGetPr(mxGetCell(cell, indp));
+    }
+    mxSetField(plhs[0],0,"infosingle",cell);
+
+    #pragma omp parallel for schedule(dynamic)
+    for(indp=0; indp<npop; indp++)
+    {
+        llrGrid     *grid = gaussModelGrid(pop[indp], bins);
+        llrTable    *tab  = llrGridToTable(grid, 0);
+        double      *thnow = (double*) malloc((nth+1)*sizeof(double));
+        double      *dinow = (double*) malloc((nth+1)*sizeof(double));
+        unsigned    ind;
+        llrDIPar    popdi;
+
+        llrGridFree(grid);
+
+        /* Information, descriptive loss, DeltaI_LS and loss curve in a single pass */
+        thnow[0] = 1;
+        for(ind=0; ind<nth; ind++) thnow[ind+1] = thetas[ind];
+        llrMeasures(tab, pop[indp]->q, thnow, nth+1, info+indp, dinow, dils+indp);
+        did[indp] = dinow[0];
+        for(ind=0; ind<nth; ind++) dicurve[(size_t)indp*nth+ind] = dinow[ind+1];
+
+        popdi.tab = tab;
+        popdi.q   = pop[indp]->q;
+        di[indp]  = llrMinimize(llrDITheta, &popdi, theta+indp);
+        llrTableFree(tab);
+        free(thnow);
+        free(dinow);
+
+        /* Shuffled responses and single neurons */
+        infosh[indp] = measuresInfoNI(pop[indp], bins, pop[indp]->d);
+        dish[indp]   = info[indp]-infosh[indp];
+        infoind[indp] = 0;
+        for(ind=0; ind<pop[indp]->d; ind++)
+        {
+            single[indp][ind] = pop[indp]->d==1 ? info[indp] : measuresInfoNI(pop[indp], bins, ind);
+            infoind[indp] += single[indp][ind];
+        }
+        syn[indp] = info[indp]-infoind[indp];
+    }
+
+    for(indp=0; indp<npop; indp++) gaussModelFree(pop[indp]);
+    mxFree(pop);
+    mxFree(single);
+}
@@ -0,0 +1,492 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Estimates online, as new trials arrive, the information transmitted by one or more
+ populations with Gaussian responses and the communication information losses caused by
+ NI decoders, as computed by dinidlGaussPops, together with their standard errors.
+
+ Each population encodes its own binary feature of the stimulus (see dinidlGaussPops.c).
+ The estimator keeps, for each population and stimulus, the number of trials and the
+ running mean and covariance matrix of the responses (Welford's updates). Each new trial
+ therefore costs a fixed amount of work, independent of the number of previous trials.
+ Standard errors are obtained with the Poisson bootstrap: besides the actual statistics,
+ the estimator keeps those of a number of replicates of the dataset, in which each trial
+ is given a random weight with Poisson distribution of mean one. The weights are
+ counter-based (see counterRNG.h), so they need not be stored.
+
+ The estimates are computed on request from the current statistics, by plugging the
+ estimated means, covariance matrices and stimulus probabilities into the Gaussian model
+ (see dinidlGaussPops.c). Their cost depends on the number of bins and replicates but not
+ on the number of trials. The minimizations over theta start around the values found in
+ the previous request, which are usually close. Replicates are distributed among the
+ available cores.
+
+ USAGE:
+
+   h   = dinidlGaussOnline('new',dims,nboot,seed)
+         dinidlGaussOnline('add',h,r,s)
+   res = dinidlGaussOnline('estimate',h,bins)
+         dinidlGaussOnline('reset',h)
+         dinidlGaussOnline('free',h)
+
+ 'new' creates an estimator for populations of dims(1), dims(2), ... neurons, with nboot
+ bootstrap replicates (default 32), and returns its handle h. The seed of the replicates
+ defaults to 0.
+
+ 'add' adds trials to the estimator h. Each row of r contains the responses of all neurons
+ of all populations in one trial, in order, and the same row of s contains the feature
+ (1 or 2) presented to each population (s may have a single column if all populations
+ share it).
+
+ 'estimate' returns a struct res with the number of trials (ntrials), the fields of
+ dinidlGaussPops (di, did, info, theta, di1p2, di12, theta12, dint12), computed with the
+ given number of bins (a power of two, default 256), and a struct res.se with their
+ bootstrap standard errors. Estimates are NaN while some population has no more trials per
+ stimulus than neurons.
+
+ 'reset' discards the trials of the estimator h, and 'free' destroys it.
+
+ The code requires the following library
+
+ - GSL (https://www.gnu.org/software/gsl/)
+
+ It should be installed wherever #include looks for headers, or
+ else, the folders in the #include statements within the c-files
+ (mex-files) should be modified.
+
+ The code can be compiled as follows
+
+   mex -v GCC='/usr/bin/gcc-4.7' CFLAGS='$CFLAGS -fopenmp' LDFLAGS='$LDFLAGS -fopenmp' -lgsl -lgslcblas -lm dinidlGaussOnline.c
+
+ where you should replace /usr/bin/gcc-4.7 for the appropriate folder
+ and C compiler compatible with your Matlab installation. The OpenMP flags are optional.
+
+ VERSION CONTROL
+
+ V1.000 (19 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#include<mex.h>
+#include<math.h>
+#include<string.h>
+#include<stdint.h>
+#include "gaussModel.h"
+#include "counterRNG.h"
+
+/* Maximum number of estimators alive at the same time */
+#define ONLINE_MAXHANDLES 64
+
+/* Number of estimates per population (di, did, info, theta) and in total (di1p2, di12,
+   theta12, dint12) */
+#define ONLINE_NPOP 4
+#define ONLINE_NJOINT 4
+
+/* Weighted number of trials, mean and sum of squared deviations of the responses of one
+   population to each stimulus */
+typedef struct
+{
+    double      w[2];
+    double      *mean[2];
+    double      *m2[2];
+} onlineStats;
+
+typedef struct
+{
+    unsigned    npop;
+    unsigned    *dim;
+    unsigned    *offset;
+    unsigned    nrep;
+    uint64_t    key;
+    double      ntrials;
+    onlineStats *stats;     /* (nrep+1) x npop, the first row being the actual dataset */
+    double      *theta;     /* previous minimizers, (nrep+1) x npop */
+    double      *theta12;   /* previous minimizers of the joint decoder, nrep+1 */
+    int         warm;
+} onlineEstimator;
+
+static onlineEstimator *onlineTable[ONLINE_MAXHANDLES];
+static int onlineRegistered = 0;
+
+void onlineReset(onlineEstimator *est)
+{
+    unsigned    ind, s, d;
+
+    for(ind=0; ind<(est->nrep+1)*est->npop; ind++)
+    {
+        d = est->dim[ind%est->npop];
+        for(s=0; s<2; s++)
+        {
+            est->stats[ind].w[s] = 0;
+            memset(est->stats[ind].mean[s], 0, d*sizeof(double));
+            memset(est->stats[ind].m2[s], 0, (size_t)d*d*sizeof(double));
+        }
+    }
+    est->ntrials = 0;
+    est->warm = 0;
+}
+
+onlineEstimator *onlineAlloc(const double *dims, unsigned npop, unsigned nrep, uint64_t seed)
+{
+    onlineEstimator *est = (onlineEstimator*) calloc(1, sizeof(onlineEstimator));
+    unsigned        ind, s, d;
+
+    est->npop    = npop;
+    est->nrep    = nrep;
+    est->key     = counterKey(seed, 0);
+    est->dim     = (unsigned*) calloc(2*npop, sizeof(unsigned));
+    est->offset  = est->dim + npop;
+    est->stats   = (onlineStats*) calloc((nrep+1)*npop, sizeof(onlineStats));
+    est->theta   = (double*) calloc((nrep+1)*(npop+1), sizeof(double));
+    est->theta12 = est->theta + (nrep+1)*npop;
+    for(ind=0; ind<npop; ind++)
+    {
+        est->dim[ind]    = (unsigned) dims[ind];
+        est->offset[ind] = ind==0 ? 0 : est->offset[ind-1]+est->dim[ind-1];
+    }
+    for(ind=0; ind<(nrep+1)*npop; ind++)
+    {
+        d = est->dim[ind%npop];
+        for(s=0; s<2; s++)
+        {
+            est->stats[ind].mean[s] = (double*) calloc((size_t)d*(d+1), sizeof(double));
+            est->stats[ind].m2[s]   = est->stats[ind].mean[s] + d;
+        }
+    }
+    onlineReset(est);
+    return est;
+}
+
+void onlineFree(onlineEstimator *est)
+{
+    unsigned    ind;
+
+    if(est==NULL) return;
+    for(ind=0; ind<(est->nrep+1)*est->npop; ind++)
+    {
+        free(est->stats[ind].mean[0]);
+        free(est->stats[ind].mean[1]);
+    }
+    free(est->stats);
+    free(est->theta);
+    free(est->dim);
+    free(est);
+}
+
+void onlineClear(void)
+{
+    unsigned    ind;
+
+    for(ind=0; ind<ONLINE_MAXHANDLES; ind++)
+    {
+        onlineFree(onlineTable[ind]);
+        onlineTable[ind] = NULL;
+    }
+}
+
+/* Adds the response x of one population to the stimulus s with weight w */
+void onlineUpdate(onlineStats *st, unsigned d, unsigned s, const double *x, double w)
+{
+    unsigned    i, j;
+    double      *mean = st->mean[s];
+    double      *m2 = st->m2[s];
+    double      delta[64];
+    double      *dl = d<=64 ? delta : (double*) malloc(d*sizeof(double));
+
+    st->w[s] += w;
+    for(i=0; i<d; i++)
+    {
+        dl[i]    = x[i]-mean[i];
+        mean[i] += w/st->w[s]*dl[i];
+    }
+    for(i=0; i<d; i++)
+        for(j=0; j<d; j++)
+            m2[i*d+j] += w*dl[i]*(x[j]-mean[j]);
+    if(dl!=delta) free(dl);
+}
+
+/* Poisson random number with mean one obtained by inversion */
+unsigned onlinePoisson(double u)
+{
+    unsigned    k = 0;
+    double      p = exp(-1.0);
+    double      cdf = p;
+
+    while(u>cdf && k<20)
+    {
+        p   /= ++k;
+        cdf += p;
+    }
+    return k;
+}
+
+/* Gaussian model of the population given the statistics, or NULL if they do not suffice */
+gaussModel *onlineModel(const onlineStats *st, unsigned d)
+{
+    gaussModel  *pop;
+    unsigned    s, i;
+
+    if(!(st->w[0]>d && st->w[1]>d)) return NULL;
+    pop = gaussModelAlloc(d);
+    pop->q = st->w[0]/(st->w[0]+st->w[1]);
+    for(s=0; s<2; s++)
+    {
+        memcpy(pop->mu[s], st->mean[s], d*sizeof(double));
+        for(i=0; i<d*d; i++) pop->C[s][i] = st->m2[s][i]/(st->w[s]-1);
+    }
+    if(!gaussModelInit(pop))
+    {
+        gaussModelFree(pop);
+        return NULL;
+    }
+    return pop;
+}
+
+/* Estimates of the replicate rep, stored in val as ONLINE_NPOP rows of npop values followed
+   by the ONLINE_NJOINT joint values */
+void onlineEstimate(onlineEstimator *est, unsigned rep, unsigned bins, double *val)
+{
+    unsigned    npop = est->npop;
+    unsigned    ind;
+    double      *di = val, *did = val+npop, *info = val+2*npop, *theta = val+3*npop;
+    double      *q = (double*) malloc(npop*sizeof(double));
+    double      di1p2 = 0;
+    gaussModel  *pop;
+    llrGrid     *grid;
+    llrTable    **tab = (llrTable**) calloc(npop, sizeof(llrTable*));
+    llrDIPar    popdi;
+    llrSumDIPar dipar;
+
+    for(ind=0; ind<ONLINE_NPOP*npop+ONLINE_NJOINT; ind++) val[ind] = NAN;
+    for(ind=0; ind<npop; ind++)
+    {
+        pop = onlineModel(est->stats+rep*npop+ind, est->dim[ind]);
+        if(pop==NULL) break;
+        q[ind]   = pop->q;
+        grid     = gaussModelGrid(pop, bins);
+        tab[ind] = llrGridToTable(grid, 0);
+        llrGridFree(grid);
+        gaussModelFree(pop);
+
+        info[ind] = llrInfo(tab[ind], q[ind]);
+        did[ind]  = llrDI(tab[ind], q[ind], 1);
+        popdi.tab = tab[ind];
+        popdi.q   = q[ind];
+        if(est->warm)
+            di[ind] = llrMinimizeNear(llrDITheta, &popdi, est->theta[rep*npop+ind], 0.25, theta+ind);
+        else
+            di[ind] = llrMinimize(llrDITheta, &popdi, theta+ind);
+        est->theta[rep*npop+ind] = theta[ind];
+        di1p2 += di[ind];
+    }
+
+    if(ind==npop)
+    {
+        dipar.num = npop;
+        dipar.tab = tab;
+        dipar.q   = q;
+        val[ONLINE_NPOP*npop]   = di1p2;
+        val[ONLINE_NPOP*npop+1] = est->warm ? llrMinimizeNear(llrSumDITheta, &dipar, est->theta12[rep], 0.25, val+ONLINE_NPOP*npop+2)
+                                            : llrMinimize(llrSumDITheta, &dipar, val+ONLINE_NPOP*npop+2);
+        val[ONLINE_NPOP*npop+3] = val[ONLINE_NPOP*npop+1]-di1p2;
+        est->theta12[rep] = val[ONLINE_NPOP*npop+2];
+    }
+
+    for(ind=0; ind<npop; ind++) llrTableFree(tab[ind]);
+    free(tab);
+    free(q);
+}
+
+/* Struct with the estimates in val, in the layout of onlineEstimate */
+mxArray *onlineStruct(const double *val, unsigned npop)
+{
+    const char  *fields[8] = {"di","did","info","theta","di1p2","di12","theta12","dint12"};
+    mxArray     *res = mxCreateStructMatrix(1,1,8,fields);
+    unsigned    ind;
+
+    for(ind=0; ind<ONLINE_NPOP; ind++)
+    {
+        mxSetField(res,0,fields[ind],mxCreateDoubleMatrix(1,npop,mxREAL));
+        memcpy(mxGetPr(mxGetField(res,0,fields[ind])), val+ind*npop, npop*sizeof(double));
+    }
+    for(ind=0; ind<ONLINE_NJOINT; ind++)
+        mxSetField(res,0,fields[ONLINE_NPOP+ind],mxCreateDoubleScalar(val[ONLINE_NPOP*npop+ind]));
+    return res;
+}
+
+onlineEstimator *onlineHandle(int nrhs, const mxArray *prhs[])
+{
+    double      h;
+
+    if(nrhs<2 || mxIsEmpty(prhs[1])) mexErrMsgTxt("Please specify the handle of the estimator");
+    h = mxGetScalar(prhs[1]);
+    if(!(h>=1 && h<=ONLINE_MAXHANDLES) || onlineTable[(int)h-1]==NULL) mexErrMsgTxt("Invalid handle");
+    return onlineTable[(int)h-1];
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    char            cmd[16];
+    onlineEstimator *est;
+
+    if(!onlineRegistered)
+    {
+        mexAtExit(onlineClear);
+        onlineRegistered = 1;
+    }
+    if(nrhs<1 || !mxIsChar(prhs[0]) || mxGetString(prhs[0], cmd, sizeof(cmd)))
+        mexErrMsgTxt("Please specify a command: 'new', 'add', 'estimate', 'reset' or 'free'");
+
+    if(!strcmp(cmd,"new"))
+    {
+        unsigned    npop, nrep = 32, ind;
+        double      seed = 0;
+        double      *dims;
+
+        if(nrhs<2 || mxIsEmpty(prhs[1])) mexErrMsgTxt("Please specify the number of neurons of each population");
+        npop = (unsigned) mxGetNumberOfElements(prhs[1]);
+        dims = mxGetPr(prhs[1]);
+        for(ind=0; ind<npop; ind++)
+            if(!(dims[ind]>=1)) mexErrMsgTxt("Each population must have at least one neuron");
+        if(nrhs>2 && !mxIsEmpty(prhs[2])) nrep = (unsigned) mxGetScalar(prhs[2]);
+        if(nrhs>3 && !mxIsEmpty(prhs[3])) seed = floor(mxGetScalar(prhs[3]));
+        if(!(seed>=0)) mexErrMsgTxt("The seed must be a nonnegative integer");
+
+        for(ind=0; ind<ONLINE_MAXHANDLES && onlineTable[ind]!=NULL; ind++);
+        if(ind==ONLINE_MAXHANDLES) mexErrMsgTxt("Too many estimators, please free some");
+        onlineTable[ind] = onlineAlloc(dims, npop, nrep, (uint64_t) seed);
+        plhs[0] = mxCreateDoubleScalar(ind+1);
+    }
+    else if(!strcmp(cmd,"add"))
+    {
+        unsigned    dtot, ntr, tr, rep, ind, s;
+        size_t      scol;
+        double      *r, *sv, w;
+
+        est  = onlineHandle(nrhs, prhs);
+        dtot = est->offset[est->npop-1]+est->dim[est->npop-1];
+        if(nrhs<4 || mxGetN(prhs[2])!=dtot) mexErrMsgTxt("The responses must have one column per neuron");
+        ntr = (unsigned) mxGetM(prhs[2]);
+        if(mxGetM(prhs[3])!=ntr || (mxGetN(prhs[3])!=1 && mxGetN(prhs[3])!=est->npop))
+            mexErrMsgTxt("The stimuli must have one row per trial and one column per population");
+        r  = mxGetPr(prhs[2]);
+        sv = mxGetPr(prhs[3]);
+        for(ind=0; ind<mxGetNumberOfElements(prhs[3]); ind++)
+            if(sv[ind]!=1 && sv[ind]!=2) mexErrMsgTxt("The stimuli must be 1 or 2");
+
+        /* Stride between the stimuli of the populations, read here since the Matlab API is
+           not thread safe */
+        scol = mxGetN(prhs[3])==1 ? 0 : ntr;
+
+        #pragma omp parallel for private(tr,ind,s,w)
+        for(rep=0; rep<=est->nrep; rep++)
+        {
+            double  *x = (double*) malloc(dtot*sizeof(double));
+
+            for(tr=0; tr<ntr; tr++)
+            {
+                w = rep==0 ? 1 : onlinePoisson(counterUniform(est->key, ((uint64_t)est->ntrials+tr)*est->nrep+rep-1));
+                if(w==0) continue;
+                for(ind=0; ind<dtot; ind++) x[ind] = r[tr+(size_t)ind*ntr];
+                for(ind=0; ind<est->npop; ind++)
+                {
+                    s = (unsigned) sv[tr+(size_t)ind*scol];
+                    onlineUpdate(est->stats+rep*est->npop+ind, est->dim[ind], s-1, x+est->offset[ind], w);
+                }
+            }
+            free(x);
+        }
+        est->ntrials += ntr;
+    }
+    else if(!strcmp(cmd,"estimate"))
+    {
+        unsigned    bins = 256;
+        unsigned    nval, ind;
+        long        rep;
+        double      *val, *se, mean, nvalid;
+        mxArray     *res;
+
+        est = onlineHandle(nrhs, prhs);
+        if(nrhs>2 && !mxIsEmpty(prhs[2])) bins = (unsigned) mxGetScalar(prhs[2]);
+        if(bins<8 || (bins&(bins-1))) mexErrMsgTxt("The number of bins must be a power of two");
+
+        nval = ONLINE_NPOP*est->npop+ONLINE_NJOINT;
+        val  = (double*) mxMalloc((est->nrep+1)*nval*sizeof(double));
+        se   = (double*) mxCalloc(nval, sizeof(double));
+
+        #pragma omp parallel for schedule(dynamic)
+        for(rep=0; rep<=(long)est->nrep; rep++)
+            onlineEstimate(est, (unsigned) rep, bins, val+rep*nval);
+        est->warm = isfinite(val[nval-1]);
+
+        /* Bootstrap standard errors over the valid replicates */
+        for(ind=0; ind<nval; ind++)
+        {
+            mean = nvalid = 0;
+            for(rep=1; rep<=(long)est->nrep; rep++)
+                if(isfinite(val[rep*nval+ind])) { mean += val[rep*nval+ind]; nvalid++; }
+            mean /= nvalid;
+            for(rep=1; rep<=(long)est->nrep; rep++)
+                if(isfinite(val[rep*nval+ind])) se[ind] += (val[rep*nval+ind]-mean)*(val[rep*nval+ind]-mean);
+            se[ind] = nvalid>1 && isfinite(val[ind]) ? sqrt(se[ind]/(nvalid-1)) : NAN;
+        }
+
+        res = onlineStruct(val, est->npop);
+        mxAddField(res, "ntrials");
+        mxSetField(res, 0, "ntrials", mxCreateDoubleScalar(est->ntrials));
+        mxAddField(res, "se");
+        mxSetField(res, 0, "se", onlineStruct(se, est->npop));
+        plhs[0] = res;
+        mxFree(val);
+        mxFree(se);
+    }
+    else if(!strcmp(cmd,"reset"))
+        onlineReset(onlineHandle(nrhs, prhs));
+    else if(!strcmp(cmd,"free"))
+    {
+        est = onlineHandle(nrhs, prhs);
+        onlineTable[(int)mxGetScalar(prhs[1])-1] = NULL;
+        onlineFree(est);
+    }
+    else
+        mexErrMsgTxt("Unknown command");
+}
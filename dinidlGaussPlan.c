@@ -0,0 +1,371 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Computes the transmitted information and the communication information losses caused by
+ NI decoders of each feature of the stimulus alone, by parallel NI decoders and by the
+ joint NI decoder, for a population of neurons with Gaussian responses whose covariance
+ matrices are block structured, without requiring the user to decompose the problem.
+
+ In Figure 4, for example, the responses of the first two neurons are correlated and encode
+ one feature, whereas the third neuron is independent of them and encodes another feature,
+ which dinidlGaussTheta exploits by splitting the integral into a two-dimensional and a
+ one-dimensional integral. Here, such splits are planned automatically:
+
+ - Neurons are grouped into blocks, namely, the connected components of the graph whose
+   edges join neurons with nonzero covariance given any stimulus. Different blocks are
+   conditionally independent given the stimulus.
+
+ - The log-likelihood ratios of blocks encoding the same feature add. Thus, the
+   characteristic function of their sum is the product of the characteristic functions of
+   the blocks (see gaussModel.h), which are computed on a shared grid of frequencies
+   distributed among the available cores. Identical blocks are computed once and raised to
+   their multiplicity, and features with identical blocks share their tables.
+
+ - The features are independent, so the losses of the joint decoder add across features
+   for each value of theta (see dinidlGaussPops.c).
+
+ USAGE:
+
+   res = dinidlGaussPlan(model,bins)
+
+ where model is a struct with fields
+
+   q        probability of the first value of each feature (one element per feature)
+   feature  feature encoded by each neuron (values from 1 to numel(q), default all 1)
+   mu1,mu2  mean responses of all neurons to the first and second value of their features
+   C1,C2    covariance matrices of all neurons given the first and second values
+
+ and bins is the number of grid bins along each log-likelihood ratio (a power of two,
+ default 512). Neurons encoding different features must be uncorrelated. The output res
+ contains the fields of dinidlGaussPops, with one element per feature, and
+
+   blocks        cell array with the neurons (indices) of each block
+   blockfeature  feature encoded by each block
+   nintegrals    number of distinct block integrals actually computed
+
+ For example, Figure 4 corresponds to
+
+   model = struct('q',[q,1-q],'feature',[1,1,2],'mu1',[-1,-1,-1],'mu2',[1,1,1],...
+                  'C1',[1,rho,0;rho,1,0;0,0,1],'C2',[1,rho,0;rho,1,0;0,0,1]);
+
+ The code requires the following library
+
+ - GSL (https://www.gnu.org/software/gsl/)
+
+ It should be installed wherever #include looks for headers, or
+ else, the folders in the #include statements within the c-files
+ (mex-files) should be modified.
+
+ The code can be compiled as follows
+
+   mex -v GCC='/usr/bin/gcc-4.7' CFLAGS='$CFLAGS -fopenmp' LDFLAGS='$LDFLAGS -fopenmp' -lgsl -lgslcblas -lm dinidlGaussPlan.c
+
+ where you should replace /usr/bin/gcc-4.7 for the appropriate folder
+ and C compiler compatible with your Matlab installation. The OpenMP flags are optional.
+
+ VERSION CONTROL
+
+ V1.000 (18 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#include<mex.h>
+#include<math.h>
+#include<string.h>
+#include "gaussModel.h"
+
+/* Block of conditionally independent neurons. Duplicated blocks point to the first block
+   with identical parameters (same), which accumulates their multiplicity (mult). */
+typedef struct
+{
+    unsigned    d;
+    unsigned    *idx;
+    unsigned    feature;
+    unsigned    mult;
+    long        same;
+    gaussModel  *pop;
+} planBlock;
+
+unsigned findRoot(unsigned *parent, unsigned ind)
+{
+    while(parent[ind]!=ind) ind = parent[ind] = parent[parent[ind]];
+    return ind;
+}
+
+int blocksEqual(const planBlock *a, const planBlock *b)
+{
+    size_t  dd = (size_t)a->d*a->d*sizeof(double);
+
+    return a->d==b->d
+        && !memcmp(a->pop->mu[0], b->pop->mu[0], a->d*sizeof(double))
+        && !memcmp(a->pop->mu[1], b->pop->mu[1], a->d*sizeof(double))
+        && !memcmp(a->pop->C[0],  b->pop->C[0],  dd)
+        && !memcmp(a->pop->C[1],  b->pop->C[1],  dd);
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    const char  *fields[11] = {"di","did","info","theta","di1p2","di12","theta12","dint12",
+                               "blocks","blockfeature","nintegrals"};
+    const char  *fmu[2] = {"mu1","mu2"};
+    const char  *fC[2]  = {"C1","C2"};
+    unsigned    bins = 512;
+    unsigned    d, nfeat, nblock = 0, nint = 0;
+    unsigned    indi, indj, indb, indc, indf, s, f;
+    unsigned    *feature, *parent, *root2block;
+    double      *q, *mu[2], *C[2];
+    double      *di, *did, *info, *theta, *val;
+    double      mean[2][2], var[2][2], mnow, vnow;
+    double      di1p2 = 0, di12, th12;
+    long        *featsame;
+    mxArray     *fld;
+    planBlock   *block;
+    llrTable    **tab;
+    llrGrid     *grid;
+    llrDIPar    popdi;
+    llrSumDIPar dipar;
+
+    if(nrhs<1 || !mxIsStruct(prhs[0])) mexErrMsgTxt("Please specify the model as a struct");
+    if(nrhs>1 && !mxIsEmpty(prhs[1])) bins = (unsigned) mxGetScalar(prhs[1]);
+    if(bins<8 || (bins&(bins-1))) mexErrMsgTxt("The number of bins must be a power of two");
+
+    /* Reading the model */
+    fld = mxGetField(prhs[0],0,"q");
+    if(fld==NULL || mxIsEmpty(fld)) mexErrMsgTxt("Missing field q");
+    nfeat = (unsigned) mxGetNumberOfElements(fld);
+    q = mxGetPr(fld);
+    for(indf=0; indf<nfeat; indf++)
+        if(!(q[indf]>0 && q[indf]<1)) mexErrMsgTxt("The values of q must be greater than zero and less than unity");
+
+    fld = mxGetField(prhs[0],0,"mu1");
+    if(fld==NULL || mxIsEmpty(fld)) mexErrMsgTxt("Missing field mu1");
+    d = (unsigned) mxGetNumberOfElements(fld);
+    for(s=0; s<2; s++)
+    {
+        fld = mxGetField(prhs[0],0,fmu[s]);
+        if(fld==NULL || mxGetNumberOfElements(fld)!=d) mexErrMsgTxt("The means must have the same number of neurons");
+        mu[s] = mxGetPr(fld);
+        fld = mxGetField(prhs[0],0,fC[s]);
+        if(fld==NULL || mxGetM(fld)!=d || mxGetN(fld)!=d) mexErrMsgTxt("The covariance matrices must be square and match the means");
+        C[s] = mxGetPr(fld);
+    }
+
+    feature = (unsigned*) mxCalloc(3*(size_t)d, sizeof(unsigned));
+    parent  = feature + d;
+    root2block = parent + d;
+    fld = mxGetField(prhs[0],0,"feature");
+    if(fld!=NULL && mxIsEmpty(fld)) fld = NULL;
+    if(fld!=NULL && mxGetNumberOfElements(fld)!=d) mexErrMsgTxt("The field feature must have one element per neuron");
+    for(indi=0; indi<d; indi++)
+    {
+        if(fld!=NULL && !(mxGetPr(fld)[indi]>=1 && mxGetPr(fld)[indi]<=nfeat))
+            mexErrMsgTxt("The features must range from 1 to the number of elements of q");
+        feature[indi] = fld==NULL ? 0 : (unsigned) mxGetPr(fld)[indi] - 1;
+        parent[indi] = indi;
+    }
+
+    /* Blocks are the connected components of the graph of nonzero covariances */
+    for(indi=0; indi<d; indi++)
+        for(indj=indi+1; indj<d; indj++)
+            if(C[0][indi+d*indj]!=0 || C[0][indj+d*indi]!=0 || C[1][indi+d*indj]!=0 || C[1][indj+d*indi]!=0)
+            {
+                if(feature[indi]!=feature[indj]) mexErrMsgTxt("Neurons encoding different features must be uncorrelated");
+                parent[findRoot(parent,indi)] = findRoot(parent,indj);
+            }
+
+    block = (planBlock*) mxCalloc(d, sizeof(planBlock));
+    for(indi=0; indi<d; indi++)
+    {
+        indj = findRoot(parent,indi);
+        if(indj==indi) root2block[indj] = nblock++;
+    }
+    for(indi=0; indi<d; indi++)
+    {
+        indb = root2block[findRoot(parent,indi)];
+        if(block[indb].idx==NULL) block[indb].idx = (unsigned*) mxCalloc(d, sizeof(unsigned));
+        block[indb].idx[block[indb].d++] = indi;
+        block[indb].feature = feature[indi];
+    }
+
+    /* Building the models of the blocks and merging identical blocks of the same feature */
+    for(indb=0; indb<nblock; indb++)
+    {
+        block[indb].mult = 1;
+        block[indb].same = -1;
+        block[indb].pop  = gaussModelAlloc(block[indb].d);
+        block[indb].pop->q = q[block[indb].feature];
+        for(s=0; s<2; s++)
+            for(indi=0; indi<block[indb].d; indi++)
+            {
+                block[indb].pop->mu[s][indi] = mu[s][block[indb].idx[indi]];
+                for(indj=0; indj<block[indb].d; indj++)
+                    block[indb].pop->C[s][indi*block[indb].d+indj] =
+                        0.5*(C[s][block[indb].idx[indi]+d*block[indb].idx[indj]] + C[s][block[indb].idx[indj]+d*block[indb].idx[indi]]);
+            }
+        if(!gaussModelInit(block[indb].pop)) mexErrMsgTxt("The covariance matrices must be positive definite");
+
+        for(indc=0; indc<indb; indc++)
+            if(block[indc].same<0 && block[indc].feature==block[indb].feature && blocksEqual(block+indc, block+indb))
+            {
+                block[indb].same = indc;
+                block[indc].mult++;
+                break;
+            }
+    }
+
+    /* Features with identical distinct blocks share their tables */
+    featsame = (long*) mxMalloc(nfeat*sizeof(long));
+    for(indf=0; indf<nfeat; indf++)
+    {
+        featsame[indf] = -1;
+        for(indc=0; indc<indf && featsame[indf]<0; indc++)
+        {
+            if(featsame[indc]>=0 || q[indc]!=q[indf]) continue;
+            featsame[indf] = indc;
+            indi = indj = 0;
+            while(featsame[indf]>=0)
+            {
+                while(indi<nblock && (block[indi].same>=0 || block[indi].feature!=indc)) indi++;
+                while(indj<nblock && (block[indj].same>=0 || block[indj].feature!=indf)) indj++;
+                if(indi==nblock || indj==nblock)
+                {
+                    if(indi!=indj) featsame[indf] = -1;
+                    break;
+                }
+                if(block[indi].mult!=block[indj].mult || !blocksEqual(block+indi, block+indj))
+                    featsame[indf] = -1;
+                indi++;
+                indj++;
+            }
+        }
+    }
+
+    plhs[0] = mxCreateStructMatrix(1,1,11,fields);
+    mxSetField(plhs[0],0,"di",   mxCreateDoubleMatrix(1,nfeat,mxREAL));
+    mxSetField(plhs[0],0,"did",  mxCreateDoubleMatrix(1,nfeat,mxREAL));
+    mxSetField(plhs[0],0,"info", mxCreateDoubleMatrix(1,nfeat,mxREAL));
+    mxSetField(plhs[0],0,"theta",mxCreateDoubleMatrix(1,nfeat,mxREAL));
+    di    = mxGetPr(mxGetField(plhs[0],0,"di"));
+    did   = mxGetPr(mxGetField(plhs[0],0,"did"));
+    info  = mxGetPr(mxGetField(plhs[0],0,"info"));
+    theta = mxGetPr(mxGetField(plhs[0],0,"theta"));
+
+    /* Distribution of the log-likelihood ratios of each feature */
+    tab = (llrTable**) mxCalloc(nfeat, sizeof(llrTable*));
+    for(indf=0; indf<nfeat; indf++)
+    {
+        if(featsame[indf]>=0)
+        {
+            tab[indf]   = tab[featsame[indf]];
+            info[indf]  = info[featsame[indf]];
+            did[indf]   = did[featsame[indf]];
+            di[indf]    = di[featsame[indf]];
+            theta[indf] = theta[featsame[indf]];
+            continue;
+        }
+
+        memset(mean, 0, sizeof(mean));
+        memset(var, 0, sizeof(var));
+        for(indb=0; indb<nblock; indb++)
+            if(block[indb].same<0 && block[indb].feature==indf)
+                for(s=0; s<2; s++)
+                    for(f=0; f<2; f++)
+                    {
+                        gaussModelMoments(block[indb].pop, s, f, &mnow, &vnow);
+                        mean[s][f] += block[indb].mult*mnow;
+                        var[s][f]  += block[indb].mult*vnow;
+                    }
+        if(mean[0][0]==0 && var[0][0]==0 && mean[1][0]==0 && var[1][0]==0)
+            mexErrMsgTxt("Every feature must be encoded by at least one neuron");
+
+        grid = llrGridAlloc(bins,bins);
+        gaussModelWindow(grid, mean, var);
+        gaussModelCFOne(grid);
+        for(indb=0; indb<nblock; indb++)
+            if(block[indb].same<0 && block[indb].feature==indf)
+            {
+                gaussModelCFGrid(block[indb].pop, grid, block[indb].mult);
+                nint++;
+            }
+        gaussModelCFInvert(grid);
+        tab[indf] = llrGridToTable(grid, 0);
+        llrGridFree(grid);
+
+        info[indf] = llrInfo(tab[indf], q[indf]);
+        did[indf]  = llrDI(tab[indf], q[indf], 1);
+        popdi.tab  = tab[indf];
+        popdi.q    = q[indf];
+        di[indf]   = llrMinimize(llrDITheta, &popdi, theta+indf);
+    }
+
+    for(indf=0; indf<nfeat; indf++) di1p2 += di[indf];
+    dipar.num = nfeat;
+    dipar.tab = tab;
+    dipar.q   = q;
+    di12 = llrMinimize(llrSumDITheta, &dipar, &th12);
+
+    mxSetField(plhs[0],0,"di1p2",  mxCreateDoubleScalar(di1p2));
+    mxSetField(plhs[0],0,"di12",   mxCreateDoubleScalar(di12));
+    mxSetField(plhs[0],0,"theta12",mxCreateDoubleScalar(th12));
+    mxSetField(plhs[0],0,"dint12", mxCreateDoubleScalar(di12-di1p2));
+    mxSetField(plhs[0],0,"nintegrals", mxCreateDoubleScalar(nint));
+
+    fld = mxCreateCellMatrix(1,nblock);
+    mxSetField(plhs[0],0,"blockfeature", mxCreateDoubleMatrix(1,nblock,mxREAL));
+    for(indb=0; indb<nblock; indb++)
+    {
+        mxSetCell(fld, indb, mxCreateDoubleMatrix(1,block[indb].d,mxREAL));
+        val = mxGetPr(mxGetCell(fld,indb));
+        for(indi=0; indi<block[indb].d; indi++) val[indi] = block[indb].idx[indi]+1;
+        mxGetPr(mxGetField(plhs[0],0,"blockfeature"))[indb] = block[indb].feature+1;
+        gaussModelFree(block[indb].pop);
+        mxFree(block[indb].idx);
+    }
+    mxSetField(plhs[0],0,"blocks", fld);
+
+    for(indf=0; indf<nfeat; indf++)
+        if(featsame[indf]<0) llrTableFree(tab[indf]);
+    mxFree(tab);
+    mxFree(featsame);
+    mxFree(block);
+    mxFree(feature);
+}
@@ -0,0 +1,174 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Computes, for any number of populations with arbitrary Gaussian responses, the
+ communication information losses caused by NI decoders of each population alone, by
+ parallel NI decoders (one per population, each with its own value of theta), and by the
+ joint NI decoder (one value of theta shared by all populations), together with the
+ destructive interference, as defined in the aforementioned publication.
+
+ As in Figure 4, each population transmits information about a different binary feature of
+ the stimulus, and the features are independent. The losses are computed from the joint
+ distribution of the true and NI log-likelihood ratios of each population (see
+ dinidlGaussLLR.c), which is obtained only once per population, in parallel, and shared by
+ all quantities. Each additional value of theta costs only a sum over these tables.
+
+ USAGE:
+
+   res = dinidlGaussPops(pops,bins)
+
+ where pops is a struct array with one element per population and fields q, mu1, mu2, C1 and
+ C2 (see dinidlGaussLLR.c), and bins is the number of grid bins along each log-likelihood
+ ratio (a power of two, default 512). The output res is a struct with fields
+
+   di      communication information loss of each population alone
+   did     descriptive information loss of each population alone
+   info    information transmitted by each population
+   theta   value of theta minimizing the loss of each population alone
+   di1p2   communication information loss caused by parallel NI decoders
+   di12    communication information loss caused by the joint NI decoder
+   theta12 value of theta minimizing the loss of the joint NI decoder
+   dint12  communication destructive interference, di12-di1p2
+
+ The code requires the following library
+
+ - GSL (https://www.gnu.org/software/gsl/)
+
+ It should be installed wherever #include looks for headers, or
+ else, the folders in the #include statements within the c-files
+ (mex-files) should be modified.
+
+ The code can be compiled as follows
+
+   mex -v GCC='/usr/bin/gcc-4.7' CFLAGS='$CFLAGS -fopenmp' LDFLAGS='$LDFLAGS -fopenmp' -lgsl -lgslcblas -lm dinidlGaussPops.c
+
+ where you should replace /usr/bin/gcc-4.7 for the appropriate folder
+ and C compiler compatible with your Matlab installation. The OpenMP flags are optional
+ and distribute the populations among the available cores.
+
+ VERSION CONTROL
+
+ V1.000 (18 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#include<mex.h>
+#include<math.h>
+#include "gaussModel.h"
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    const char  *fields[8] = {"di","did","info","theta","di1p2","di12","theta12","dint12"};
+    unsigned    bins = 512;
+    unsigned    npop;
+    long        indp;
+    double      *di, *did, *info, *theta, *q;
+    double      di1p2 = 0;
+    double      di12, th12;
+    gaussModel  **pop;
+    llrTable    **tab;
+    llrSumDIPar dipar;
+
+    if(nrhs<1) mexErrMsgTxt("Please specify the populations");
+    if(nrhs>1 && !mxIsEmpty(prhs[1])) bins = (unsigned) mxGetScalar(prhs[1]);
+    if(bins<8 || (bins&(bins-1))) mexErrMsgTxt("The number of bins must be a power of two");
+
+    npop = (unsigned) mxGetNumberOfElements(prhs[0]);
+    if(npop==0) mexErrMsgTxt("Please specify at least one population");
+
+    plhs[0] = mxCreateStructMatrix(1,1,8,fields);
+    mxSetField(plhs[0],0,"di",   mxCreateDoubleMatrix(1,npop,mxREAL));
+    mxSetField(plhs[0],0,"did",  mxCreateDoubleMatrix(1,npop,mxREAL));
+    mxSetField(plhs[0],0,"info", mxCreateDoubleMatrix(1,npop,mxREAL));
+    mxSetField(plhs[0],0,"theta",mxCreateDoubleMatrix(1,npop,mxREAL));
+    di    = mxGetPr(mxGetField(plhs[0],0,"di"));
+    did   = mxGetPr(mxGetField(plhs[0],0,"did"));
+    info  = mxGetPr(mxGetField(plhs[0],0,"info"));
+    theta = mxGetPr(mxGetField(plhs[0],0,"theta"));
+
+    /* The Matlab API is not thread safe, so the populations are read beforehand */
+    pop = (gaussModel**) mxMalloc(npop*sizeof(gaussModel*));
+    tab = (llrTable**) mxMalloc(npop*sizeof(llrTable*));
+    q   = (double*) mxMalloc(npop*sizeof(double));
+    for(indp=0; indp<npop; indp++)
+    {
+        pop[indp] = gaussModelFromStruct(prhs[0], indp);
+        q[indp]   = pop[indp]->q;
+    }
+
+    #pragma omp parallel for schedule(dynamic)
+    for(indp=0; indp<npop; indp++)
+    {
+        llrGrid     *grid = gaussModelGrid(pop[indp], bins);
+        llrDIPar    popdi;
+
+        tab[indp]   = llrGridToTable(grid, 0);
+        llrGridFree(grid);
+
+        info[indp]  = llrInfo(tab[indp], q[indp]);
+        did[indp]   = llrDI(tab[indp], q[indp], 1);
+        popdi.tab   = tab[indp];
+        popdi.q     = q[indp];
+        di[indp]    = llrMinimize(llrDITheta, &popdi, theta+indp);
+    }
+
+    for(indp=0; indp<npop; indp++) di1p2 += di[indp];
+
+    dipar.num  = npop;
+    dipar.tab  = tab;
+    dipar.q    = q;
+    di12 = llrMinimize(llrSumDITheta, &dipar, &th12);
+
+    mxSetField(plhs[0],0,"di1p2",  mxCreateDoubleScalar(di1p2));
+    mxSetField(plhs[0],0,"di12",   mxCreateDoubleScalar(di12));
+    mxSetField(plhs[0],0,"theta12",mxCreateDoubleScalar(th12));
+    mxSetField(plhs[0],0,"dint12", mxCreateDoubleScalar(di12-di1p2));
+
+    for(indp=0; indp<npop; indp++)
+    {
+        llrTableFree(tab[indp]);
+        gaussModelFree(pop[indp]);
+    }
+    mxFree(pop);
+    mxFree(tab);
+    mxFree(q);
+}
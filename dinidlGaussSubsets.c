@@ -0,0 +1,246 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Computes the information and the information loss caused by the NI decoder for random
+ subsets of neurons drawn from a recorded population, as needed to study how these
+ quantities scale with the number of neurons. The responses of the whole population are
+ modelled as Gaussian, as in dinidlGaussPops.c, and the model of each subset is obtained
+ from the means and the covariance sub-blocks of its neurons.
+
+ Subsets are generated in chains: each chain is a random ordering of the neurons, and its
+ subset of size k contains the first k neurons of the ordering. Along a chain, the subsets
+ grow one neuron at a time, so the Cholesky factors of their covariance matrices are
+ updated by appending one row instead of being recomputed. Chains are distributed among
+ the available cores.
+
+ USAGE:
+
+   res = dinidlGaussSubsets(pop,sizes,nchains,seed,bins)
+
+ where pop is a struct with fields q, mu1, mu2, C1 and C2 describing the whole population
+ (as in dinidlGaussPops.c), sizes is a vector with the numbers of neurons of the subsets,
+ nchains is the number of subsets of each size (default 100), seed is a nonnegative integer
+ (default 0), and bins is the number of bins per axis of the grids of log-likelihood ratios
+ (power of two, default 256). The output res is a struct with fields
+
+   sizes    the sizes of the subsets, sorted in increasing order.
+   neurons  nchains x max(sizes) matrix with the ordering of the neurons of each chain.
+            The subset of size k of chain c is neurons(c,1:k).
+   info     nchains x numel(sizes) matrix with the information of each subset.
+   did      Same as info, but with the descriptive information loss.
+   di       Same as info, but with the minimum information loss of the NI decoder.
+   theta    Same as info, but with the value of theta that minimizes the loss.
+
+ Information is measured in nats.
+
+ This code uses the GNU Scientific Library (GSL), which can be downloaded from
+
+   http://www.gnu.org/software/gsl/
+
+ It should be installed wherever #include looks for headers, or
+ else, the folders in the #include statements within the c-files
+ (mex-files) should be modified.
+
+ The code can be compiled as follows
+
+   mex -v GCC='/usr/bin/gcc-4.7' CFLAGS='$CFLAGS -fopenmp' LDFLAGS='$LDFLAGS -fopenmp' -lgsl -lgslcblas -lm dinidlGaussSubsets.c
+
+ where you should replace /usr/bin/gcc-4.7 for the appropriate folder
+ and C compiler compatible with your Matlab installation. The OpenMP flags are optional
+ and distribute the chains among the available cores.
+
+ VERSION CONTROL
+
+ V1.000 (19 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#include<mex.h>
+#include<math.h>
+#include<stdlib.h>
+#include "gaussModel.h"
+#include "counterRNG.h"
+
+int subsetsCompare(const void *a, const void *b)
+{
+    double  da = *(const double*)a;
+    double  db = *(const double*)b;
+
+    return (da>db) - (da<db);
+}
+
+/* Model of the first k neurons of the ordering ord of the population full, with the rows of
+   the Cholesky factors of the covariance matrices appended from size k0 to k. The factors
+   Lc have leading dimension full->d and persist along the chain. */
+int subsetsModel(const gaussModel *full, const unsigned *ord, unsigned k0, unsigned k, double *Lc[2], double *col, gaussModel *sub)
+{
+    unsigned    D = full->d;
+    unsigned    s, i, j;
+
+    for(s=0; s<2; s++)
+    {
+        for(j=k0; j<k; j++)
+        {
+            for(i=0; i<=j; i++) col[i] = full->C[s][ord[i]*D+ord[j]];
+            if(!choleskyAppend(Lc[s], D, j, col)) return 0;
+        }
+        for(i=0; i<k; i++)
+        {
+            sub->mu[s][i] = full->mu[s][ord[i]];
+            for(j=0; j<k; j++)
+            {
+                sub->C[s][i*k+j] = full->C[s][ord[i]*D+ord[j]];
+                sub->L[s][i*k+j] = Lc[s][i*D+j];
+            }
+        }
+    }
+    sub->q = full->q;
+    gaussModelInitFactored(sub);
+    return 1;
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    const char  *fields[6] = {"sizes","neurons","info","did","di","theta"};
+    unsigned    nchains = 100, bins = 256;
+    unsigned    nsize, kmax, D, ind;
+    double      seed = 0;
+    double      *sizes, *neurons, *info, *did, *di, *theta;
+    long        indc;
+    int         failed = 0;
+    uint64_t    key;
+    gaussModel  *full;
+
+    if(nrhs<2) mexErrMsgTxt("Please specify the population and the sizes of the subsets");
+    full = gaussModelFromStruct(prhs[0], 0);
+    D    = full->d;
+    if(nrhs>2 && !mxIsEmpty(prhs[2])) nchains = (unsigned) mxGetScalar(prhs[2]);
+    if(nrhs>3 && !mxIsEmpty(prhs[3])) seed = floor(mxGetScalar(prhs[3]));
+    if(nrhs>4 && !mxIsEmpty(prhs[4])) bins = (unsigned) mxGetScalar(prhs[4]);
+    if(bins<8 || (bins&(bins-1))) mexErrMsgTxt("The number of bins must be a power of two");
+    if(!(seed>=0)) mexErrMsgTxt("The seed must be a nonnegative integer");
+
+    nsize = (unsigned) mxGetNumberOfElements(prhs[1]);
+    if(nsize==0 || nchains==0) mexErrMsgTxt("Please specify at least one size and one chain");
+    plhs[0] = mxCreateStructMatrix(1,1,6,fields);
+    mxSetField(plhs[0],0,"sizes",mxCreateDoubleMatrix(1,nsize,mxREAL));
+    sizes = mxGetPr(mxGetField(plhs[0],0,"sizes"));
+    memcpy(sizes, mxGetPr(prhs[1]), nsize*sizeof(double));
+    qsort(sizes, nsize, sizeof(double), subsetsCompare);
+    for(ind=0; ind<nsize; ind++)
+        if(!(sizes[ind]>=1 && sizes[ind]<=D && sizes[ind]==floor(sizes[ind])))
+            mexErrMsgTxt("The sizes must be integers between one and the number of neurons");
+    kmax = (unsigned) sizes[nsize-1];
+
+    mxSetField(plhs[0],0,"neurons",mxCreateDoubleMatrix(nchains,kmax,mxREAL));
+    mxSetField(plhs[0],0,"info",   mxCreateDoubleMatrix(nchains,nsize,mxREAL));
+    mxSetField(plhs[0],0,"did",    mxCreateDoubleMatrix(nchains,nsize,mxREAL));
+    mxSetField(plhs[0],0,"di",     mxCreateDoubleMatrix(nchains,nsize,mxREAL));
+    mxSetField(plhs[0],0,"theta",  mxCreateDoubleMatrix(nchains,nsize,mxREAL));
+    neurons = mxGetPr(mxGetField(plhs[0],0,"neurons"));
+    info    = mxGetPr(mxGetField(plhs[0],0,"info"));
+    did     = mxGetPr(mxGetField(plhs[0],0,"did"));
+    di      = mxGetPr(mxGetField(plhs[0],0,"di"));
+    theta   = mxGetPr(mxGetField(plhs[0],0,"theta"));
+
+    key = counterKey((uint64_t) seed, 0);
+
+    #pragma omp parallel for schedule(dynamic)
+    for(indc=0; indc<(long)nchains; indc++)
+    {
+        unsigned    *ord = (unsigned*) malloc(D*sizeof(unsigned));
+        double      *Lc[2], *col = (double*) malloc((D+1)*sizeof(double));
+        unsigned    i, sw, tmp, k, k0 = 0, inds;
+        double      dinow[1];
+        double      one = 1;
+        gaussModel  *sub;
+        llrGrid     *grid;
+        llrTable    *tab;
+        llrDIPar    popdi;
+
+        Lc[0] = (double*) malloc(2*(size_t)D*D*sizeof(double));
+        Lc[1] = Lc[0] + (size_t)D*D;
+
+        /* Random ordering of the neurons, partial Fisher-Yates shuffle */
+        for(i=0; i<D; i++) ord[i] = i;
+        for(i=0; i<kmax; i++)
+        {
+            sw  = i + (unsigned) (counterUniform(key, (uint64_t)indc*D+i)*(D-i));
+            if(sw>=D) sw = D-1;
+            tmp = ord[i]; ord[i] = ord[sw]; ord[sw] = tmp;
+            neurons[indc+(size_t)nchains*i] = ord[i]+1;
+        }
+
+        for(inds=0; inds<nsize; inds++)
+        {
+            k   = (unsigned) sizes[inds];
+            sub = gaussModelAlloc(k);
+            if(!subsetsModel(full, ord, k0, k, Lc, col, sub))
+            {
+                #pragma omp atomic write
+                failed = 1;
+                gaussModelFree(sub);
+                break;
+            }
+            k0 = k;
+
+            grid = gaussModelGrid(sub, bins);
+            tab  = llrGridToTable(grid, 0);
+            llrGridFree(grid);
+
+            llrMeasures(tab, sub->q, &one, 1, info+indc+(size_t)nchains*inds, dinow, NULL);
+            did[indc+(size_t)nchains*inds] = dinow[0];
+            popdi.tab = tab;
+            popdi.q   = sub->q;
+            di[indc+(size_t)nchains*inds] = llrMinimize(llrDITheta, &popdi, theta+indc+(size_t)nchains*inds);
+
+            llrTableFree(tab);
+            gaussModelFree(sub);
+        }
+        free(ord);
+        free(col);
+        free(Lc[0]);
+    }
+
+    gaussModelFree(full);
+    if(failed) mexErrMsgTxt("The covariance matrices must be positive definite");
+}
@@ -14,6 +14,25 @@
  This code is part of the Matlab class Fig4codeC.m. It requires to download 
  some additional libraries and to compile it within Matlab.
 
+ The terms psx*log(psx/pisx) of the loss are Gaussian expectations of quadratic forms
+ over the integration box, which are computed in closed form with the error function and
+ the bivariate normal distribution (Genz, 2004). Only the mixture term px*log(px/pix) is
+ integrated numerically, in log space, so that it never underflows or overflows. Unlike
+ V1.000, which dropped the points where psx/pisx overflowed, the loss thus includes their
+ contribution, which matters only for correlations close to 1 in magnitude.
+
+ USAGE:
+
+   di = dinidlGaussTheta(par,depth)
+
+ where par = [q,rho1,rho2] and depth is optional. With depth = 0 (default), the loss is
+ computed sequentially. With depth > 0, the two-dimensional and one-dimensional integrals
+ of each value of theta, as well as the three initial values of theta, are computed
+ concurrently, and the minimization is performed by a golden-section search that
+ evaluates speculatively all 2^depth-1 points that the next depth iterations may need.
+ Thus, up to 2^(depth+1)-2 integrals run at once (e.g., depth = 3 for 16 cores), reducing
+ the time per call when the computer is otherwise idle.
+
  Specifically, the code requires the following libraries
 
  - GSL (https://www.gnu.org/software/gsl/)
@@ -25,14 +44,18 @@
 
  The code can be compiled as follows
  
-   mex -v GCC='/usr/bin/gcc-4.7' -lgsl -lgslcblas -lm dinidlGaussTheta.c
+   mex -v GCC='/usr/bin/gcc-4.7' CFLAGS='$CFLAGS -fopenmp' LDFLAGS='$LDFLAGS -fopenmp' -lgsl -lgslcblas -lm dinidlGaussTheta.c
 
  where you should replace /usr/bin/gcc-4.7 for the appropriate folder
- and C compiler compatible with your Matlab installation.
+ and C compiler compatible with your Matlab installation. The OpenMP flags are optional,
+ but without them depth > 0 brings no benefit.
 
  VERSION CONTROL
 
  V1.000 Hugo Gabriel Eyherabide (10 Feb 2017)
+ V1.001 Optional parallel mode with speculative golden-section search (19 Oct 2026)
+ V1.002 Log-likelihood ratios evaluated as quadratic forms (19 Oct 2026)
+ V1.003 Cross-entropy terms in closed form, only the mixture term integrated (19 Oct 2026)
 
  Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
 
@@ -75,6 +98,143 @@
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_min.h>
 
+/* Standard normal density and cumulative distribution */
+static inline double normPdf(double x)
+{
+    return exp(-0.5*x*x)/sqrt(2.0*M_PI);
+}
+
+static inline double normCdf(double x)
+{
+    return 0.5*erfc(-x/M_SQRT2);
+}
+
+/* log(exp(a)+exp(b)) without overflow */
+static inline double logAdd(double a, double b)
+{
+    return a>b ? a+log1p(exp(b-a)) : b+log1p(exp(a-b));
+}
+
+/* Probability that a standard bivariate normal vector with correlation r exceeds (h,k),
+   computed as in Genz (2004), Statistics and Computing 14:251-260 */
+double bvnUpper(double h, double k, double r)
+{
+    const double    w6[3]   = {0.1713244923791705, 0.3607615730481384, 0.4679139345726904};
+    const double    x6[3]   = {0.9324695142031522, 0.6612093864662647, 0.2386191860831970};
+    const double    w12[6]  = {0.04717533638651177, 0.1069393259953183, 0.1600783285433464,
+                               0.2031674267230659, 0.2334925365383547, 0.2491470458134029};
+    const double    x12[6]  = {0.9815606342467191, 0.9041172563704750, 0.7699026741943050,
+                               0.5873179542866171, 0.3678314989981802, 0.1252334085114692};
+    const double    w20[10] = {0.01761400713915212, 0.04060142980038694, 0.06267204833410906,
+                               0.08327674157670475, 0.1019301198172404, 0.1181945319615184,
+                               0.1316886384491766, 0.1420961093183821, 0.1491729864726037,
+                               0.1527533871307259};
+    const double    x20[10] = {0.9931285991850949, 0.9639719272779138, 0.9122344282513259,
+                               0.8391169718222188, 0.7463319064601508, 0.6360536807265150,
+                               0.5108670019508271, 0.3737060887154196, 0.2277858511416451,
+                               0.07652652113349733};
+    const double    *w, *x;
+    unsigned        n, i, sgn;
+    double          hk = h*k, bvn = 0, hs, asr, sn, as, a, bs, c, d, b, xs, rs, ep, sp;
+
+    if(r==0) return normCdf(-h)*normCdf(-k);
+    if(fabs(r)<0.3)       { w = w6;  x = x6;  n = 3;  }
+    else if(fabs(r)<0.75) { w = w12; x = x12; n = 6;  }
+    else                  { w = w20; x = x20; n = 10; }
+
+    if(fabs(r)<0.925)
+    {
+        hs  = (h*h+k*k)/2;
+        asr = asin(r)/2;
+        for(i=0; i<n; i++)
+            for(sgn=0; sgn<2; sgn++)
+            {
+                sn   = sin(asr*(sgn ? 1+x[i] : 1-x[i]));
+                bvn += w[i]*exp((sn*hk-hs)/(1-sn*sn));
+            }
+        return bvn*asr/(2*M_PI) + normCdf(-h)*normCdf(-k);
+    }
+
+    if(r<0)
+    {
+        k  = -k;
+        hk = -hk;
+    }
+    if(fabs(r)<1)
+    {
+        as  = 1-r*r;
+        a   = sqrt(as);
+        bs  = (h-k)*(h-k);
+        c   = (4-hk)/8;
+        d   = (12-hk)/80;
+        asr = -(bs/as+hk)/2;
+        if(asr>-100) bvn = a*exp(asr)*(1-c*(bs-as)*(1-d*bs)/3+c*d*as*as);
+        if(hk>-100)
+        {
+            b    = sqrt(bs);
+            sp   = sqrt(2*M_PI)*normCdf(-b/a);
+            bvn -= exp(-hk/2)*sp*b*(1-c*bs*(1-d*bs)/3);
+        }
+        a  /= 2;
+        sp  = 0;
+        for(i=0; i<n; i++)
+            for(sgn=0; sgn<2; sgn++)
+            {
+                xs  = a*(sgn ? 1+x[i] : 1-x[i]);
+                xs *= xs;
+                asr = -(bs/xs+hk)/2;
+                if(asr<=-100) continue;
+                rs  = sqrt(1-xs);
+                ep  = exp(-(hk/2)*xs/((1+rs)*(1+rs)))/rs;
+                sp += w[i]*exp(asr)*(1+c*xs*(1+5*d*xs)-ep);
+            }
+        bvn = (a*sp-bvn)/(2*M_PI);
+    }
+    if(r>0) bvn += normCdf(-(h>k ? h : k));
+    else if(h>=k) bvn = -bvn;
+    else bvn = (h<0 ? normCdf(k)-normCdf(h) : normCdf(-h)-normCdf(-k)) - bvn;
+    return bvn<0 ? 0 : (bvn>1 ? 1 : bvn);
+}
+
+/* Integrals over the box [lo,hi]^xdim of the standard normal density with correlation rho
+   times 1 (mom[0]), the sum of the squared coordinates (mom[1]) and their product (mom[2]).
+   Since y*phi(y) = -Sigma*grad(phi(y)), the moments reduce to integrals over the faces of
+   the box, which involve only the one-dimensional normal distribution. */
+void boxMoments(unsigned xdim, double rho, double lo, double hi, double mom[3])
+{
+    double  s = sqrt(1-rho*rho);
+    double  c[2] = {lo, hi};
+    double  face[2], cface[2], yface[2], al, be;
+    unsigned ind;
+
+    if(xdim==1)
+    {
+        mom[0] = normCdf(hi)-normCdf(lo);
+        mom[1] = mom[0]-(hi*normPdf(hi)-lo*normPdf(lo));
+        mom[2] = 0;
+        return;
+    }
+
+    /* Integrals over the face y_j = c of the density, of c times it, and of y_i times it */
+    for(ind=0; ind<2; ind++)
+    {
+        al         = (lo-rho*c[ind])/s;
+        be         = (hi-rho*c[ind])/s;
+        face[ind]  = normPdf(c[ind])*(normCdf(be)-normCdf(al));
+        cface[ind] = c[ind]*face[ind];
+        yface[ind] = normPdf(c[ind])*(rho*c[ind]*(normCdf(be)-normCdf(al))
+                                      -s*(normPdf(be)-normPdf(al)));
+    }
+    mom[0] = bvnUpper(lo,lo,rho)-bvnUpper(lo,hi,rho)-bvnUpper(hi,lo,rho)+bvnUpper(hi,hi,rho);
+    mom[1] = 2*(mom[0]-(cface[1]-cface[0])-rho*(yface[1]-yface[0]));
+    mom[2] = rho*mom[0]-rho*(cface[1]-cface[0])-(yface[1]-yface[0]);
+}
+
+/* Since px and pix are mixtures of Gaussians, DI = sum_s int psx*log(psx/pisx) - int
+   px*log(px/pix). In the first term, log(psx/pisx) is the quadratic form params[10+s] +
+   (params[4+s]-params[8+s])*xc2sum + params[6+s]*xcprod, whose Gaussian expectations over
+   the box are computed in closed form (see diThetaPart). This integrand is the remaining
+   mixture term, whose logarithms are taken in log space so that it remains finite. */
 int NDIntegrand(unsigned xdim, unsigned numx, const double *x, void *par, unsigned didim, double *dival)
 {
     unsigned    indx;
@@ -82,11 +242,10 @@ int NDIntegrand(unsigned xdim, unsigned numx, const double *x, void *par, unsign
     unsigned    indmu;
     double      *params = (double*) par;
     
-    double      psx;
-    double      pisx;
-    double      px;
-    double      pix;
-    double      dinow;
+    double      lpsx[2];
+    double      lpisx[2];
+    double      lpx;
+    double      lpix;
     double      xc;
     double      xc2sum;
     double      xcprod;
@@ -94,10 +253,6 @@ int NDIntegrand(unsigned xdim, unsigned numx, const double *x, void *par, unsign
     
     for(indx=0; indx<numx; indx++)
     {
-        dinow = 0;
-        px  = 0;
-        pix = 0;
-        
         for(indmu=0;indmu<2;indmu++)
         {
             xc2sum = 0;
@@ -114,24 +269,14 @@ int NDIntegrand(unsigned xdim, unsigned numx, const double *x, void *par, unsign
             xc2sum *= -0.5;
 
             params += indmu;
-            psx  = params[2]*exp(params[4]*xc2sum+params[6]*xcprod);
-            pisx = params[0]*exp(params[8]*xc2sum);
+            lpisx[indmu] = params[12]+params[8]*xc2sum;
+            lpsx[indmu]  = lpisx[indmu]+params[10]+(params[4]-params[8])*xc2sum+params[6]*xcprod;
             params -= indmu; 
-            
-            px  += psx;
-            pix += pisx;   
-        
-            dinow += psx * log(psx/pisx);
-            if(!isfinite(dinow)) break;
         }
         
-        if(isfinite(dinow)) 
-        {
-            dinow -= px * log(px/pix);
-            dival[indx] = isfinite(dinow) ? dinow : 0;
-        }
-        else
-            dival[indx] = 0;
+        lpx  = logAdd(lpsx[0], lpsx[1]);
+        lpix = logAdd(lpisx[0], lpisx[1]);
+        dival[indx] = -exp(lpx)*(lpx-lpix);
             
         x+=xdim;    
     }
@@ -139,61 +284,212 @@ int NDIntegrand(unsigned xdim, unsigned numx, const double *x, void *par, unsign
     return 0;
 }
         
-double diTheta(double th, double * const par)
+/* Two-dimensional (part=0) or one-dimensional (part=1) contribution to the communication
+   information loss. Both parts are independent and can be computed concurrently. */
+double diThetaPart(double th, double * const par, unsigned part)
 {
-    double  dival2D;
-    double  dival1D;
+    double  dival;
     double  errorval;
-    double  params[10];
+    double  params[14];
+    double  mom[3];
     double  xmin[2]={-5,-5};     
     double  xmax[2]={5,5};     
+    double  mu[2] = {1,-1};
+    unsigned indmu;
     
-    params[0] = par[0];
-    params[1] = 1-par[0];
-    params[4] = 1.0/(1.0-par[1]*par[1]); 
-    params[5] = 1.0/(1.0-par[2]*par[2]);
-    params[2] = params[0]*sqrt(params[4])/(2.0*M_PI);
-    params[3] = params[1]*sqrt(params[5])/(2.0*M_PI);
-    params[6] = par[1]*params[4];
-    params[7] = par[2]*params[5];
+    if(part==0)
+    {
+        params[0] = par[0];
+        params[1] = 1-par[0];
+        params[4] = 1.0/(1.0-par[1]*par[1]); 
+        params[5] = 1.0/(1.0-par[2]*par[2]);
+        params[2] = params[0]*sqrt(params[4])/(2.0*M_PI);
+        params[3] = params[1]*sqrt(params[5])/(2.0*M_PI);
+        params[6] = par[1]*params[4];
+        params[7] = par[2]*params[5];
+    }
+    else
+    {
+        params[0] = 1-par[0];
+        params[1] = par[0];
+        params[4] = 1; 
+        params[5] = 1;
+        params[2] = params[0]/sqrt(2.0*M_PI);
+        params[3] = params[1]/sqrt(2.0*M_PI);
+        params[6] = 0;
+        params[7] = 0;
+    }
     params[8] = th; 
     params[9] = th; 
+    params[10] = log(params[2]/params[0]);
+    params[11] = log(params[3]/params[1]);
+    params[12] = log(params[0]);
+    params[13] = log(params[1]);
     
-    hcubature_v(1, NDIntegrand, params, 2, xmin, xmax, 1000, 1E-6,1E-3,ERROR_INDIVIDUAL,&dival2D,&errorval);
-    
-    params[0] = params[1];
-    params[1] = par[0];
-    params[4] = 1; 
-    params[5] = 1;
-    params[2] = params[0]/sqrt(2.0*M_PI);
-    params[3] = params[1]/sqrt(2.0*M_PI);
-    params[6] = 0;
-    params[7] = 0;
-    
-    hcubature_v(1, NDIntegrand, params, 1, xmin, xmax, 1000, 1E-6,1E-3,ERROR_INDIVIDUAL,&dival1D,&errorval);
+    hcubature_v(1, NDIntegrand, params, 2-part, xmin, xmax, 1000, 1E-6,1E-3,ERROR_INDIVIDUAL,&dival,&errorval);
+
+    /* Cross-entropy terms: psx is params[indmu] times the normal density of xc = x+mu, whose
+       correlation is params[6+indmu]/params[4+indmu], over the box shifted by mu */
+    for(indmu=0; indmu<2; indmu++)
+    {
+        boxMoments(2-part, params[6+indmu]/params[4+indmu],
+                   xmin[0]+mu[indmu], xmax[0]+mu[indmu], mom);
+        dival += params[indmu]*(params[10+indmu]*mom[0]
+                                -0.5*(params[4+indmu]-params[8+indmu])*mom[1]
+                                +params[6+indmu]*mom[2]);
+    }
+    return dival;
+}
+
+double diTheta(double th, double * const par)
+{
+    double  dival2D = diThetaPart(th,par,0);
+    double  dival1D = diThetaPart(th,par,1);
 
     return dival1D+dival2D;
 }
+
+/* Computes the losses for num values of theta at once, distributing the 2*num cubatures
+   among the available cores */
+void diThetaMany(const double *th, unsigned num, double * const par, double *di)
+{
+    double  *part = (double*) malloc(2*num*sizeof(double));
+    long    ind;
+
+    #pragma omp parallel for schedule(dynamic)
+    for(ind=0; ind<2*(long)num; ind++)
+        part[ind] = diThetaPart(th[ind/2],par,(unsigned)(ind%2));
+
+    for(ind=0; ind<num; ind++) di[ind] = part[2*ind+1]+part[2*ind];
+    free(part);
+}
+
+double diThetaPar(double th, void *par)
+{
+    double  di;
+
+    diThetaMany(&th,1,(double*)par,&di);
+    return di;
+}
+
+/* State of the golden-section search: the minimum lies within [a,b] and f(x)=fx is the
+   smallest value found so far, with a < x < b */
+typedef struct
+{
+    double  a;
+    double  b;
+    double  x;
+    double  fx;
+} goldState;
+
+/* Next point evaluated by the golden-section search, which depends only on a, b and x */
+double goldPoint(const goldState *st)
+{
+    const double golden = 0.3819660112501051;
+
+    if(st->b-st->x > st->x-st->a)
+        return st->x + golden*(st->b-st->x);
+    return st->x - golden*(st->x-st->a);
+}
+
+/* Updates the state after evaluating f(u)=fu. If better is nonzero (fu < fx), u becomes the
+   new x. */
+void goldUpdate(goldState *st, double u, double fu, int better)
+{
+    if(better)
+    {
+        if(u>st->x) st->a = st->x; else st->b = st->x;
+        st->x  = u;
+        st->fx = fu;
+    }
+    else
+    {
+        if(u>st->x) st->b = u; else st->a = u;
+    }
+}
+
+/* Golden-section search that speculatively evaluates the points of the next depth
+   iterations at once. Since the point of each iteration depends only on the outcomes of the
+   previous comparisons, the 2^depth-1 points that may be needed form a binary tree, which
+   is planned beforehand and evaluated in parallel. */
+double goldSpeculative(double thl, double thm, double thr, double dim, double * const par, unsigned depth)
+{
+    unsigned    num = (1u<<depth)-1;
+    unsigned    ind, node, level;
+    int         better;
+    goldState   root = {thl, thr, thm, dim};
+    goldState   *st = (goldState*) malloc(num*sizeof(goldState));
+    double      *th = (double*) malloc(2*num*sizeof(double));
+    double      *di = th + num;
+
+    while(gsl_min_test_interval(root.a, root.b, 1E-6, 1E-3) == GSL_CONTINUE)
+    {
+        /* Planning the tree of candidate points (children of node i are 2i+1 and 2i+2) */
+        st[0] = root;
+        for(ind=0; ind<num; ind++)
+        {
+            th[ind] = goldPoint(st+ind);
+            if(2*ind+2<num)
+            {
+                st[2*ind+1] = st[2*ind+2] = st[ind];
+                goldUpdate(st+2*ind+1, th[ind], 0, 1);
+                goldUpdate(st+2*ind+2, th[ind], 0, 0);
+            }
+        }
+
+        diThetaMany(th,num,par,di);
+
+        /* Following the branch selected by the actual values */
+        node = 0;
+        for(level=0; level<depth; level++)
+        {
+            better = di[node]<root.fx;
+            goldUpdate(&root, th[node], di[node], better);
+            if(gsl_min_test_interval(root.a, root.b, 1E-6, 1E-3) != GSL_CONTINUE) break;
+            node = 2*node + (better ? 1 : 2);
+        }
+    }
+
+    free(st);
+    free(th);
+    return root.fx;
+}
       
 void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
 {
     double  *par = (double*) mxGetPr(prhs[0]);
     plhs[0] = mxCreateDoubleScalar(mxREAL);
     double  *di = (double*) mxGetPr(plhs[0]);
+    unsigned depth = (nrhs>1 && !mxIsEmpty(prhs[1])) ? (unsigned) mxGetScalar(prhs[1]) : 0;
+    double  (*ditheta)(double, void*) = depth ? &diThetaPar : (double(*)(double, void*)) &diTheta;
     
     double thl = -0.5;
     double thm = 0.5;
     double thr = 1.5;
-    double dil = diTheta(thl,par);
-    double dim = diTheta(thm,par);
-    double dir = diTheta(thr,par);
+    double dil, dim, dir;
+    
+    if(depth>10) mexErrMsgTxt("The speculation depth must not exceed 10");
+    if(depth)
+    {
+        /* Initial probes computed concurrently */
+        double thp[3] = {thl, thm, thr};
+        double dip[3];
+        diThetaMany(thp,3,par,dip);
+        dil = dip[0]; dim = dip[1]; dir = dip[2];
+    }
+    else
+    {
+        dil = diTheta(thl,par);
+        dim = diTheta(thm,par);
+        dir = diTheta(thr,par);
+    }
     
     /* Looking for lower limit of minimization interval*/
     while(dil<dim)
     {
         dir=dim; dim=dil;
         thr=thm; thm=thl; 
-        dil = diTheta(thl*=2,par);
+        dil = ditheta(thl*=2,par);
     }
     
     /* Looking for upper limit of minimization interval*/
@@ -201,9 +497,15 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
     {
         dil=dim; dim=dir;
         thl=thm; thm=thr;
-        dir=diTheta(thr*=2,par);
+        dir=ditheta(thr*=2,par);
     }
     
+    if(depth)
+    {
+        *di = goldSpeculative(thl, thm, thr, dim, par, depth);
+        return;
+    }
+
     /* Minimizing the communication information loss*/
     gsl_function dith;
     dith.function = &diTheta;
@@ -0,0 +1,93 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Computes the communication information losses depicted in Figure 4 of the
+ aforementioned publication, under the conditions stated in Section 3.6, as done by
+ dinidlGaussTheta, but with the templated cubature and minimization of
+ templateCubature.hpp instead of the Cubature and GSL libraries.
+
+ The integrand is a class, defined in figIntegrands.hpp, whose parameters are fixed when
+ the class is constructed and whose number of dimensions is a template parameter. It is
+ therefore inlined within the integration rules, the loops over dimensions are unrolled,
+ and the terms that do not depend on the responses are computed only once per value of
+ theta.
+
+ USAGE:
+
+   [di,theta] = dinidlGaussThetaT(par)
+
+ where par = [q,rho1,rho2], di is the communication information loss and theta is the
+ value of theta attaining it.
+
+ The code requires no external library, and can be compiled as follows
+
+   mex -v GCC='/usr/bin/g++-4.7' dinidlGaussThetaT.cpp
+
+ where you should replace /usr/bin/g++-4.7 for the appropriate folder
+ and C++ compiler compatible with your Matlab installation.
+
+ VERSION CONTROL
+
+ V1.000 (19 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#include<mex.h>
+#include<cmath>
+#include "templateCubature.hpp"
+#include "figIntegrands.hpp"
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    double  *par;
+    double  di, th;
+
+    if(nrhs<1 || mxGetNumberOfElements(prhs[0])!=3) mexErrMsgTxt("Please specify par = [q,rho1,rho2]");
+    par = mxGetPr(prhs[0]);
+    if(!(par[0]>0 && par[0]<1) || !(fabs(par[1])<1) || !(fabs(par[2])<1))
+        mexErrMsgTxt("The parameters must satisfy 0<q<1, |rho1|<1 and |rho2|<1");
+
+    di = minimizeTheta(FigLoss(par), &th);
+
+    plhs[0] = mxCreateDoubleScalar(di);
+    if(nlhs>1) plhs[1] = mxCreateDoubleScalar(th);
+}
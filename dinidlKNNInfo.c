@@ -0,0 +1,584 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Estimates, from samples, the information transmitted by continuous responses about a
+ discrete stimulus, and the descriptive information loss caused by the NI decoder, using
+ k-nearest neighbours instead of a model of the responses (e.g., for calcium imaging).
+
+ The information is estimated with the method of Kraskov et al. (2004) for mixed discrete
+ and continuous variables (Ross, 2014): for each sample, the distance to its k-th nearest
+ neighbour among the samples with the same stimulus (in the maximum norm) is found, and the
+ samples of any stimulus within that distance are counted, yielding
+
+   I = psi(N) - <psi(Ns)> + psi(k) - <psi(m)>,
+
+ where psi is the digamma function, N is the number of samples, Ns is the number of samples
+ with the stimulus of each sample, and m is the count. The loss is estimated as the mean of
+ log p(s|r) - log pNI(s|r) over the samples, where both posteriors are obtained from
+ k-nearest-neighbour density estimates. The NI likelihoods pNI(r|s) are estimated from
+ surrogate samples in which the response of each neuron is shuffled independently among
+ the trials with the same stimulus, which destroys the noise correlations but keeps the
+ marginal distributions. As for the samples, whose own-class likelihoods leave the trial
+ out, the surrogate samples that take the response of any neuron from the trial are left
+ out of its own-class NI likelihood.
+
+ The neighbours are searched with k-d trees, one per stimulus for the samples and for the
+ surrogates, and one for all samples. All queries are distributed among the available
+ cores. Information is measured in nats.
+
+ USAGE:
+
+   res = dinidlKNNInfo(r,s,k,seed)
+
+ where r is a matrix with one row per trial and one column per neuron, s is a vector with
+ the stimulus of each trial (any set of integers), k is the number of neighbours (default
+ 4), and seed is a nonnegative integer for the surrogates (default 0). The output res is
+ a struct with fields info (information), did (descriptive information loss), k and n (number
+ of trials). Each stimulus must have more than k+d trials, where d is the number of neurons.
+
+ Ties: when k+1 samples are identical (e.g., integer spike counts, or zero responses in
+ calcium data), the k-th neighbour distance is zero and the density estimates diverge. As
+ recommended by Kraskov et al. (2004), a uniform jitter of amplitude 1E-10 times the range
+ of each neuron's responses (or 1E-10 if they are all zero) is added to the responses
+ beforehand, drawn from the seed. The jitter changes the estimates of data without ties
+ only by rounding. Responses that are not finite produce an error.
+
+ The code can be compiled as follows
+
+   mex -v GCC='/usr/bin/gcc-4.7' CFLAGS='$CFLAGS -fopenmp' LDFLAGS='$LDFLAGS -fopenmp' -lm dinidlKNNInfo.c
+
+ where you should replace /usr/bin/gcc-4.7 for the appropriate folder
+ and C compiler compatible with your Matlab installation. The OpenMP flags are optional.
+
+ VERSION CONTROL
+
+ V1.000 (19 Oct 2026)
+ V1.001 Surrogates built from the trial left out of its NI likelihood (19 Oct 2026)
+ V1.002 Three-way partition of the k-d trees, and jitter to break ties (19 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#include<mex.h>
+#include<math.h>
+#include<stdint.h>
+#include<string.h>
+#include "counterRNG.h"
+
+/* Maximum number of points per leaf */
+#define KD_LEAF 16
+
+/* Amplitude of the jitter added to the responses to break ties, relative to their range */
+#define KNN_JITTER 1E-10
+
+/* Node of a k-d tree over the points begin to end-1, with bounding box [lo,hi] */
+typedef struct
+{
+    size_t      begin;
+    size_t      end;
+    long        left;
+    long        right;
+} kdNode;
+
+/* k-d tree over n points of d dimensions, stored row-major in the order of the leaves */
+typedef struct
+{
+    unsigned    d;
+    size_t      n;
+    double      *pts;
+    size_t      *idx;       /* original index of each point */
+    kdNode      *node;
+    double      *box;       /* lo and hi of each node, 2*d values */
+    long        nnode;
+} kdTree;
+
+void kdSwap(kdTree *tree, size_t a, size_t b)
+{
+    unsigned    j;
+    double      tmp;
+    size_t      ti;
+
+    if(a==b) return;
+    for(j=0; j<tree->d; j++)
+    {
+        tmp = tree->pts[a*tree->d+j];
+        tree->pts[a*tree->d+j] = tree->pts[b*tree->d+j];
+        tree->pts[b*tree->d+j] = tmp;
+    }
+    ti = tree->idx[a];
+    tree->idx[a] = tree->idx[b];
+    tree->idx[b] = ti;
+}
+
+/* Reorders the points begin to end-1 so that the point mid has the median coordinate dim.
+   Each pass splits the points into those below, equal to and above the pivot, so that
+   ties (e.g., spike counts) are settled at once instead of one point per pass. */
+void kdSelect(kdTree *tree, size_t begin, size_t end, size_t mid, unsigned dim)
+{
+    size_t      lo = begin, hi = end-1, lt, gt, i;
+    double      pivot, v;
+
+    while(hi>lo)
+    {
+        pivot = tree->pts[(lo+(hi-lo)/2)*tree->d+dim];
+        lt = i = lo;
+        gt = hi;
+        while(i<=gt)
+        {
+            v = tree->pts[i*tree->d+dim];
+            if(v<pivot) kdSwap(tree, i++, lt++);
+            else if(v>pivot)
+            {
+                kdSwap(tree, i, gt);
+                if(gt==lo) break;
+                gt--;
+            }
+            else i++;
+        }
+        if(mid<lt) hi = lt-1;
+        else if(mid>gt) lo = gt+1;
+        else return;
+    }
+}
+
+long kdBuildNode(kdTree *tree, size_t begin, size_t end)
+{
+    long        ind = tree->nnode++;
+    unsigned    j, dim = 0;
+    size_t      i;
+    double      *lo = tree->box + (size_t)ind*2*tree->d;
+    double      *hi = lo + tree->d;
+    double      v;
+
+    tree->node[ind].begin = begin;
+    tree->node[ind].end   = end;
+    tree->node[ind].left  = tree->node[ind].right = -1;
+    for(j=0; j<tree->d; j++)
+    {
+        lo[j] = INFINITY;
+        hi[j] = -INFINITY;
+    }
+    for(i=begin; i<end; i++)
+        for(j=0; j<tree->d; j++)
+        {
+            v = tree->pts[i*tree->d+j];
+            if(v<lo[j]) lo[j] = v;
+            if(v>hi[j]) hi[j] = v;
+        }
+
+    if(end-begin>KD_LEAF)
+    {
+        for(j=1; j<tree->d; j++)
+            if(hi[j]-lo[j]>hi[dim]-lo[dim]) dim = j;
+        kdSelect(tree, begin, end, begin+(end-begin)/2, dim);
+        tree->node[ind].left  = kdBuildNode(tree, begin, begin+(end-begin)/2);
+        tree->node[ind].right = kdBuildNode(tree, begin+(end-begin)/2, end);
+    }
+    return ind;
+}
+
+/* Builds the tree over the points of the rows sel of the n x d column-major matrix x. If
+   perm is not NULL, column j of point i is taken from row perm[j*num+i] instead. */
+kdTree *kdBuild(const double *x, size_t n, unsigned d, const size_t *sel, size_t num, const size_t *perm)
+{
+    kdTree      *tree = (kdTree*) malloc(sizeof(kdTree));
+    size_t      i;
+    unsigned    j;
+
+    tree->d     = d;
+    tree->n     = num;
+    tree->pts   = (double*) malloc((num*d+1)*sizeof(double));
+    tree->idx   = (size_t*) malloc((num+1)*sizeof(size_t));
+    tree->node  = (kdNode*) malloc((2*num/KD_LEAF*2+2)*sizeof(kdNode));
+    tree->box   = (double*) malloc((2*num/KD_LEAF*2+2)*2*(size_t)d*sizeof(double));
+    tree->nnode = 0;
+    for(i=0; i<num; i++)
+    {
+        tree->idx[i] = sel[i];
+        for(j=0; j<d; j++)
+            tree->pts[i*d+j] = x[(perm==NULL ? sel[i] : sel[perm[j*num+i]]) + j*n];
+    }
+    if(num>0) kdBuildNode(tree, 0, num);
+    return tree;
+}
+
+void kdFree(kdTree *tree)
+{
+    free(tree->pts);
+    free(tree->idx);
+    free(tree->node);
+    free(tree->box);
+    free(tree);
+}
+
+/* Maximum-norm distance from q to the box of the node */
+static inline double kdBoxDist(const kdTree *tree, long ind, const double *q)
+{
+    const double    *lo = tree->box + (size_t)ind*2*tree->d;
+    const double    *hi = lo + tree->d;
+    double          dist = 0, now;
+    unsigned        j;
+
+    for(j=0; j<tree->d; j++)
+    {
+        now = q[j]<lo[j] ? lo[j]-q[j] : (q[j]>hi[j] ? q[j]-hi[j] : 0);
+        if(now>dist) dist = now;
+    }
+    return dist;
+}
+
+/* Inserts dist in the sorted list of the k smallest distances */
+static inline void kdInsert(double *best, unsigned k, double dist)
+{
+    unsigned    i = k-1;
+
+    if(dist>=best[i]) return;
+    while(i>0 && best[i-1]>dist)
+    {
+        best[i] = best[i-1];
+        i--;
+    }
+    best[i] = dist;
+}
+
+void kdKnnNode(const kdTree *tree, long ind, const double *q, const size_t *skip, unsigned nskip,
+               unsigned k, double *best)
+{
+    const kdNode    *nd = tree->node+ind;
+    size_t          i;
+    unsigned        j;
+    double          dist, now, dl, dr;
+
+    if(kdBoxDist(tree, ind, q)>=best[k-1]) return;
+    if(nd->left<0)
+    {
+        for(i=nd->begin; i<nd->end; i++)
+        {
+            for(j=0; j<nskip && tree->idx[i]!=skip[j]; j++);
+            if(j<nskip) continue;
+            dist = 0;
+            for(j=0; j<tree->d; j++)
+            {
+                now = fabs(tree->pts[i*tree->d+j]-q[j]);
+                if(now>dist) dist = now;
+            }
+            kdInsert(best, k, dist);
+        }
+        return;
+    }
+    dl = kdBoxDist(tree, nd->left, q);
+    dr = kdBoxDist(tree, nd->right, q);
+    if(dl<=dr)
+    {
+        kdKnnNode(tree, nd->left, q, skip, nskip, k, best);
+        kdKnnNode(tree, nd->right, q, skip, nskip, k, best);
+    }
+    else
+    {
+        kdKnnNode(tree, nd->right, q, skip, nskip, k, best);
+        kdKnnNode(tree, nd->left, q, skip, nskip, k, best);
+    }
+}
+
+/* Distance from q to its k-th nearest neighbour in the tree, excluding the nskip points
+   whose original indices are in skip. The workspace best must hold k values. */
+double kdKnn(const kdTree *tree, const double *q, const size_t *skip, unsigned nskip, unsigned k,
+             double *best)
+{
+    unsigned    i;
+
+    for(i=0; i<k; i++) best[i] = INFINITY;
+    if(tree->n>0) kdKnnNode(tree, 0, q, skip, nskip, k, best);
+    return best[k-1];
+}
+
+/* Number of points within distance r of q */
+size_t kdCount(const kdTree *tree, long ind, const double *q, double r)
+{
+    const kdNode    *nd = tree->node+ind;
+    const double    *lo = tree->box + (size_t)ind*2*tree->d;
+    const double    *hi = lo + tree->d;
+    size_t          i, count = 0;
+    unsigned        j;
+    int             inside = 1;
+
+    if(kdBoxDist(tree, ind, q)>r) return 0;
+    for(j=0; j<tree->d && inside; j++) inside = hi[j]-q[j]<=r && q[j]-lo[j]<=r;
+    if(inside) return nd->end-nd->begin;
+    if(nd->left>=0) return kdCount(tree, nd->left, q, r) + kdCount(tree, nd->right, q, r);
+    for(i=nd->begin; i<nd->end; i++)
+    {
+        for(j=0; j<tree->d && fabs(tree->pts[i*tree->d+j]-q[j])<=r; j++);
+        if(j==tree->d) count++;
+    }
+    return count;
+}
+
+/* Digamma function for x > 0 */
+double digamma(double x)
+{
+    double  res = 0, x2;
+
+    while(x<6)
+    {
+        res -= 1/x;
+        x   += 1;
+    }
+    x2   = 1/(x*x);
+    res += log(x) - 0.5/x - x2*(1.0/12 - x2*(1.0/120 - x2*(1.0/252 - x2*(1.0/240 - x2/132))));
+    return res;
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    const char  *fields[4] = {"info","did","k","n"};
+    unsigned    k = 4, d, ncls = 0, c;
+    size_t      n, i, j;
+    long        ind;
+    double      seed = 0;
+    double      *r, *s, *label;
+    double      info = 0, did = 0, lo, hi, amp;
+    long        nzero = 0;
+    size_t      *ncount, **members, *cls, *fill, *rank;
+    size_t      **perm, **inv;
+    kdTree      *all, **real, **surr;
+    uint64_t    key;
+
+    if(nrhs<2) mexErrMsgTxt("Please specify the responses and the stimuli");
+    n = mxGetM(prhs[0]);
+    d = (unsigned) mxGetN(prhs[0]);
+    s = mxGetPr(prhs[1]);
+    if(mxGetNumberOfElements(prhs[1])!=n) mexErrMsgTxt("Please specify one stimulus per trial");
+    if(nrhs>2 && !mxIsEmpty(prhs[2])) k = (unsigned) mxGetScalar(prhs[2]);
+    if(nrhs>3 && !mxIsEmpty(prhs[3])) seed = floor(mxGetScalar(prhs[3]));
+    if(k<1 || d<1) mexErrMsgTxt("The number of neighbours and of neurons must be positive");
+    if(!(seed>=0)) mexErrMsgTxt("The seed must be a nonnegative integer");
+
+    /* Responses with a jitter that breaks the ties */
+    r   = (double*) mxMalloc(n*d*sizeof(double));
+    key = counterKey((uint64_t) seed, 1);
+    memcpy(r, mxGetPr(prhs[0]), n*d*sizeof(double));
+    for(j=0; j<d; j++)
+    {
+        lo = hi = n>0 ? r[j*n] : 0;
+        for(i=0; i<n; i++)
+        {
+            if(!isfinite(r[i+j*n])) mexErrMsgTxt("The responses must be finite");
+            if(r[i+j*n]<lo) lo = r[i+j*n];
+            if(r[i+j*n]>hi) hi = r[i+j*n];
+        }
+        amp = KNN_JITTER*(hi>lo ? hi-lo : (fabs(hi)>0 ? fabs(hi) : 1));
+        for(i=0; i<n; i++) r[i+j*n] += amp*(2*counterUniform(key, j*n+i)-1);
+    }
+
+    /* Classes of stimuli and their trials */
+    label  = (double*) mxMalloc(n*sizeof(double));
+    cls    = (size_t*) mxMalloc(n*sizeof(size_t));
+    for(i=0; i<n; i++)
+    {
+        for(c=0; c<ncls && label[c]!=s[i]; c++);
+        if(c==ncls) label[ncls++] = s[i];
+        cls[i] = c;
+    }
+    ncount  = (size_t*) mxCalloc(2*ncls, sizeof(size_t));
+    fill    = ncount + ncls;
+    members = (size_t**) mxMalloc(ncls*sizeof(size_t*));
+    perm    = (size_t**) mxMalloc(ncls*sizeof(size_t*));
+    inv     = (size_t**) mxMalloc(ncls*sizeof(size_t*));
+    rank    = (size_t*) mxMalloc(n*sizeof(size_t));
+    for(i=0; i<n; i++) ncount[cls[i]]++;
+    for(c=0; c<ncls; c++)
+    {
+        if(ncount[c]<=k+d)
+            mexErrMsgTxt("Each stimulus must have more trials than neighbours and neurons together");
+        members[c] = (size_t*) mxMalloc(ncount[c]*sizeof(size_t));
+    }
+    for(i=0; i<n; i++)
+    {
+        rank[i] = fill[cls[i]];
+        members[cls[i]][fill[cls[i]]++] = i;
+    }
+
+    /* Surrogates: independent permutations of each neuron within each class. Surrogate
+       inv[c][j*ncount[c]+i] takes the response of neuron j from the i-th trial of class c. */
+    key = counterKey((uint64_t) seed, 0);
+    for(c=0; c<ncls; c++)
+    {
+        perm[c] = (size_t*) mxMalloc(ncount[c]*d*sizeof(size_t));
+        inv[c]  = (size_t*) mxMalloc(ncount[c]*d*sizeof(size_t));
+        for(j=0; j<d; j++)
+        {
+            size_t  *p = perm[c]+j*ncount[c];
+            size_t  tmp, sw;
+
+            for(i=0; i<ncount[c]; i++) p[i] = i;
+            for(i=ncount[c]-1; i>0; i--)
+            {
+                sw    = (size_t) (counterUniform(key, ((uint64_t)c*d+j)*n+i)*(i+1));
+                tmp   = p[i];
+                p[i]  = p[sw];
+                p[sw] = tmp;
+            }
+            for(i=0; i<ncount[c]; i++) inv[c][j*ncount[c]+p[i]] = i;
+        }
+    }
+
+    /* Trees, built in parallel */
+    real = (kdTree**) mxMalloc(ncls*sizeof(kdTree*));
+    surr = (kdTree**) mxMalloc(ncls*sizeof(kdTree*));
+    #pragma omp parallel for schedule(dynamic)
+    for(ind=0; ind<=2*(long)ncls; ind++)
+    {
+        if(ind==2*(long)ncls)
+        {
+            size_t  *sel = (size_t*) malloc(n*sizeof(size_t));
+            size_t  t;
+
+            for(t=0; t<n; t++) sel[t] = t;
+            all = kdBuild(r, n, d, sel, n, NULL);
+            free(sel);
+        }
+        else if(ind<(long)ncls)
+            real[ind] = kdBuild(r, n, d, members[ind], ncount[ind], NULL);
+        else
+            surr[ind-ncls] = kdBuild(r, n, d, members[ind-ncls], ncount[ind-ncls], perm[ind-ncls]);
+    }
+
+    #pragma omp parallel reduction(+:info,did,nzero)
+    {
+        double      *q = (double*) malloc(d*sizeof(double));
+        double      *best = (double*) malloc(k*sizeof(double));
+        double      *lreal = (double*) malloc(2*ncls*sizeof(double));
+        double      *lsurr = lreal + ncls;
+        size_t      *skip = (size_t*) malloc(d*sizeof(size_t));
+        double      eps, mreal, msurr, sreal, ssurr;
+        size_t      m, self;
+        unsigned    cn, cs, jn, nskip, js;
+
+        #pragma omp for schedule(dynamic,256)
+        for(ind=0; ind<(long)n; ind++)
+        {
+            for(jn=0; jn<d; jn++) q[jn] = r[ind+jn*n];
+
+            /* Surrogates of its class built from the trial */
+            cs = (unsigned) cls[ind];
+            for(jn=0, nskip=0; jn<d; jn++)
+            {
+                self = members[cs][inv[cs][jn*ncount[cs]+rank[ind]]];
+                for(js=0; js<nskip && skip[js]!=self; js++);
+                if(js==nskip) skip[nskip++] = self;
+            }
+            self = (size_t) ind;
+
+            /* Information (Ross, 2014) */
+            eps = kdKnn(real[cls[ind]], q, &self, 1, k, best);
+            nzero += eps==0;
+            m   = kdCount(all, 0, q, eps) - 1;
+            info += digamma(n) - digamma(ncount[cls[ind]]) + digamma(k) - digamma(m);
+
+            /* Log-likelihoods, up to a common constant, from the k-th neighbour distances */
+            for(cn=0; cn<ncls; cn++)
+            {
+                eps = kdKnn(real[cn], q, &self, cn==cls[ind], k, best);
+                nzero += eps==0;
+                lreal[cn] = log((double)ncount[cn]/n) - digamma(ncount[cn]-(cn==cls[ind])) - d*log(eps);
+                eps = kdKnn(surr[cn], q, skip, cn==cls[ind] ? nskip : 0, k, best);
+                nzero += eps==0;
+                lsurr[cn] = log((double)ncount[cn]/n) - digamma(ncount[cn]-(cn==cls[ind] ? nskip : 0)) - d*log(eps);
+            }
+            mreal = msurr = -INFINITY;
+            for(cn=0; cn<ncls; cn++)
+            {
+                if(lreal[cn]>mreal) mreal = lreal[cn];
+                if(lsurr[cn]>msurr) msurr = lsurr[cn];
+            }
+            sreal = ssurr = 0;
+            for(cn=0; cn<ncls; cn++)
+            {
+                sreal += exp(lreal[cn]-mreal);
+                ssurr += exp(lsurr[cn]-msurr);
+            }
+            did += (lreal[cls[ind]]-mreal-log(sreal)) - (lsurr[cls[ind]]-msurr-log(ssurr));
+        }
+        free(q);
+        free(best);
+        free(lreal);
+        free(skip);
+    }
+
+    /* The jitter leaves no ties unless it is below the resolution of the responses */
+    if(nzero>0)
+    {
+        kdFree(all);
+        for(c=0; c<ncls; c++)
+        {
+            kdFree(real[c]);
+            kdFree(surr[c]);
+        }
+        mexErrMsgTxt("Identical samples remain after the jitter; please rescale the responses");
+    }
+
+    plhs[0] = mxCreateStructMatrix(1,1,4,fields);
+    mxSetField(plhs[0],0,"info",mxCreateDoubleScalar(info/n));
+    mxSetField(plhs[0],0,"did", mxCreateDoubleScalar(did/n));
+    mxSetField(plhs[0],0,"k",   mxCreateDoubleScalar(k));
+    mxSetField(plhs[0],0,"n",   mxCreateDoubleScalar((double)n));
+
+    kdFree(all);
+    for(c=0; c<ncls; c++)
+    {
+        kdFree(real[c]);
+        kdFree(surr[c]);
+        mxFree(members[c]);
+        mxFree(perm[c]);
+        mxFree(inv[c]);
+    }
+    mxFree(real);
+    mxFree(surr);
+    mxFree(members);
+    mxFree(perm);
+    mxFree(inv);
+    mxFree(rank);
+    mxFree(ncount);
+    mxFree(cls);
+    mxFree(label);
+    mxFree(r);
+}
@@ -0,0 +1,296 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Computes the transmitted information and the descriptive and communication information
+ losses caused by NI decoders when a binary stimulus is encoded by many conditionally
+ independent information streams, each of which is a two-neuron population with the
+ Gaussian responses used in Figure 4 of the aforementioned publication.
+
+ The true and NI posteriors depend on the responses only through the log-likelihood
+ ratios of each stream, which add across streams. The joint distribution of the pair of
+ log-likelihood ratios is tabulated on a grid for each kind of stream, and the streams
+ are combined through FFT convolution (see llrTable.h). Hence, the cost is a handful of
+ two-dimensional FFTs regardless of the number of streams.
+
+ USAGE:
+
+   [di,did,info,theta] = dinidlLLRConv(par,num,bins)
+
+ where each row of par is [q,rho1,rho2] for one kind of stream (q must be the same for all
+ rows), num contains the number of streams of each kind (default 1), and bins is the number
+ of grid bins along each log-likelihood ratio (a power of two, default 1024). The outputs are
+ the communication information loss, the descriptive information loss, the transmitted
+ information and the value of theta minimizing the information loss.
+
+ The code requires the following library
+
+ - GSL (https://www.gnu.org/software/gsl/)
+
+ It should be installed wherever #include looks for headers, or
+ else, the folders in the #include statements within the c-files
+ (mex-files) should be modified.
+
+ The code can be compiled as follows
+
+   mex -v GCC='/usr/bin/gcc-4.7' -lgsl -lgslcblas -lm dinidlLLRConv.c
+
+ where you should replace /usr/bin/gcc-4.7 for the appropriate folder
+ and C compiler compatible with your Matlab installation.
+
+ VERSION CONTROL
+
+ V1.000 (18 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#include<mex.h>
+#include<math.h>
+#include<string.h>
+#include "llrTable.h"
+
+/* Number of points per dimension used to tabulate each stream on [-5,5]x[-5,5] */
+#define STREAMGRID 512
+
+/* Log-likelihood ratios and probabilities of the responses of a two-neuron stream on the
+   tabulation mesh, together with their moments and the range of relevant values */
+typedef struct
+{
+    double      *lam;
+    double      *ell;
+    double      *mass[2];
+    double      mean[2][2];
+    double      var[2][2];
+    double      lo[2];
+    double      hi[2];
+} llrStream;
+
+void streamTabulate(llrStream *st, double rho1, double rho2)
+{
+    unsigned    indx;
+    unsigned    indy;
+    unsigned    ind;
+    unsigned    inds;
+    unsigned    inda;
+    unsigned    num = STREAMGRID*STREAMGRID;
+    double      dx = 10.0/STREAMGRID;
+    double      x, y, xc, yc;
+    double      lp[2];
+    double      rho[2] = {rho1,rho2};
+    double      mu[2] = {1,-1};
+    double      val[2];
+    double      mmax = 0;
+    double      mtot;
+
+    st->lam     = (double*) malloc(4*(size_t)num*sizeof(double));
+    st->ell     = st->lam + num;
+    st->mass[0] = st->ell + num;
+    st->mass[1] = st->mass[0] + num;
+
+    for(indx=0, ind=0; indx<STREAMGRID; indx++)
+        for(indy=0; indy<STREAMGRID; indy++, ind++)
+        {
+            x = -5 + (indx+0.5)*dx;
+            y = -5 + (indy+0.5)*dx;
+            for(inds=0; inds<2; inds++)
+            {
+                xc = x + mu[inds];
+                yc = y + mu[inds];
+                lp[inds] = -0.5*(xc*xc+yc*yc-2*rho[inds]*xc*yc)/(1-rho[inds]*rho[inds])
+                           -0.5*log(1-rho[inds]*rho[inds]) - log(2*M_PI);
+                st->mass[inds][ind] = exp(lp[inds])*dx*dx;
+                if(st->mass[inds][ind]>mmax) mmax = st->mass[inds][ind];
+            }
+            st->lam[ind] = lp[0]-lp[1];
+            st->ell[ind] = -2*(x+y);
+        }
+
+    /* Moments of the log-likelihood ratios and range of values with non-negligible mass */
+    mmax *= 1E-16;
+    for(inda=0; inda<2; inda++)
+    {
+        st->lo[inda] = INFINITY;
+        st->hi[inda] = -INFINITY;
+        for(inds=0; inds<2; inds++)
+            st->mean[inds][inda] = st->var[inds][inda] = 0;
+    }
+    for(inds=0; inds<2; inds++)
+    {
+        mtot = 0;
+        for(ind=0; ind<num; ind++)
+        {
+            val[0] = st->lam[ind];
+            val[1] = st->ell[ind];
+            mtot  += st->mass[inds][ind];
+            for(inda=0; inda<2; inda++)
+            {
+                st->mean[inds][inda] += st->mass[inds][ind]*val[inda];
+                st->var[inds][inda]  += st->mass[inds][ind]*val[inda]*val[inda];
+                if(st->mass[inds][ind]>mmax)
+                {
+                    if(val[inda]<st->lo[inda]) st->lo[inda] = val[inda];
+                    if(val[inda]>st->hi[inda]) st->hi[inda] = val[inda];
+                }
+            }
+        }
+        for(inda=0; inda<2; inda++)
+        {
+            st->mean[inds][inda] /= mtot;
+            st->var[inds][inda]   = st->var[inds][inda]/mtot - st->mean[inds][inda]*st->mean[inds][inda];
+        }
+    }
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    double      *par = (double*) mxGetPr(prhs[0]);
+    unsigned    ntype = (unsigned) mxGetM(prhs[0]);
+    unsigned    bins = 1024;
+    unsigned    *num;
+    unsigned    indk;
+    unsigned    inds;
+    unsigned    inda;
+    unsigned    ind;
+    unsigned    ntot = 0;
+    double      q = par[0];
+    double      wlo[2], whi[2];
+    double      clo, chi;
+    double      mtot, vtot;
+    double      rmax;
+    double      orig[2];
+    double      th;
+    double      di, did, info;
+    llrStream   *st;
+    llrGrid     *acc;
+    llrGrid     *grid;
+    llrTable    *tab;
+    llrDIPar    dipar;
+
+    if(mxGetN(prhs[0])!=3) mexErrMsgTxt("Each row of the first argument must be [q,rho1,rho2]");
+    if(nrhs>2 && !mxIsEmpty(prhs[2])) bins = (unsigned) mxGetScalar(prhs[2]);
+    if(bins<8 || (bins&(bins-1))) mexErrMsgTxt("The number of bins must be a power of two");
+
+    num = (unsigned*) mxMalloc(ntype*sizeof(unsigned));
+    for(indk=0; indk<ntype; indk++)
+    {
+        if(par[indk]!=q) mexErrMsgTxt("All streams must share the same value of q");
+        num[indk] = (nrhs>1 && !mxIsEmpty(prhs[1])) ? (unsigned) mxGetPr(prhs[1])[indk] : 1;
+        ntot += num[indk];
+    }
+    if(ntot==0) mexErrMsgTxt("At least one stream is required");
+
+    st = (llrStream*) mxMalloc(ntype*sizeof(llrStream));
+    for(indk=0; indk<ntype; indk++)
+        streamTabulate(st+indk, par[indk+ntype], par[indk+2*ntype]);
+
+    /* The grid window is the support of the sum, or the central limit approximation of its
+       bulk plus the widest stream, whichever is narrower. */
+    for(inda=0; inda<2; inda++)
+    {
+        wlo[inda] = whi[inda] = rmax = 0;
+        for(indk=0; indk<ntype; indk++)
+        {
+            wlo[inda] += num[indk]*st[indk].lo[inda];
+            whi[inda] += num[indk]*st[indk].hi[inda];
+            if(st[indk].hi[inda]-st[indk].lo[inda]>rmax) rmax = st[indk].hi[inda]-st[indk].lo[inda];
+        }
+        clo = INFINITY;
+        chi = -INFINITY;
+        for(inds=0; inds<2; inds++)
+        {
+            mtot = vtot = 0;
+            for(indk=0; indk<ntype; indk++)
+            {
+                mtot += num[indk]*st[indk].mean[inds][inda];
+                vtot += num[indk]*st[indk].var[inds][inda];
+            }
+            if(mtot-14*sqrt(vtot)-rmax<clo) clo = mtot-14*sqrt(vtot)-rmax;
+            if(mtot+14*sqrt(vtot)+rmax>chi) chi = mtot+14*sqrt(vtot)+rmax;
+        }
+        if(clo>wlo[inda]) wlo[inda] = clo;
+        if(chi<whi[inda]) whi[inda] = chi;
+        if(whi[inda]-wlo[inda]<1E-9) { wlo[inda] -= 0.5; whi[inda] += 0.5; }
+    }
+
+    acc  = llrGridAlloc(bins,bins);
+    grid = llrGridAlloc(bins,bins);
+    for(inda=0; inda<2; inda++)
+    {
+        acc->h[inda]  = (whi[inda]-wlo[inda])/(bins-2);
+        acc->lo[inda] = wlo[inda];
+        orig[inda]    = wlo[inda]/ntot;
+    }
+    for(ind=0; ind<2*bins*bins; ind+=2)
+        acc->val[0][ind] = acc->val[1][ind] = 1;
+
+    /* Every stream is deposited relative to its share of the origin of the window */
+    for(indk=0; indk<ntype; indk++)
+    {
+        if(num[indk]==0) continue;
+        memset(grid->val[0], 0, 4*(size_t)bins*bins*sizeof(double));
+        for(inds=0; inds<2; inds++)
+            for(ind=0; ind<STREAMGRID*STREAMGRID; ind++)
+                llrGridDeposit(grid, inds, (st[indk].lam[ind]-orig[0])/acc->h[0],
+                               (st[indk].ell[ind]-orig[1])/acc->h[1], st[indk].mass[inds][ind]);
+        llrGridFFT(grid, 1);
+        llrGridMulPow(acc, grid, num[indk]);
+    }
+    llrGridFFT(acc, -1);
+
+    tab  = llrGridToTable(acc, 1);
+    info = llrInfo(tab, q);
+    did  = llrDI(tab, q, 1);
+    dipar.tab = tab;
+    dipar.q   = q;
+    di = llrMinimize(llrDITheta, &dipar, &th);
+
+    plhs[0] = mxCreateDoubleScalar(di);
+    if(nlhs>1) plhs[1] = mxCreateDoubleScalar(did);
+    if(nlhs>2) plhs[2] = mxCreateDoubleScalar(info);
+    if(nlhs>3) plhs[3] = mxCreateDoubleScalar(th);
+
+    llrTableFree(tab);
+    llrGridFree(grid);
+    llrGridFree(acc);
+    for(indk=0; indk<ntype; indk++) free(st[indk].lam);
+    mxFree(st);
+    mxFree(num);
+}
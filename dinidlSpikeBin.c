@@ -0,0 +1,333 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Converts spike times into spike counts for many bin widths at once, so that the
+ information and the information losses computed by the other mex-files can be studied as
+ functions of the width of the time window used to count spikes.
+
+ For each neuron, the spike times are read only once. In continuous mode, they are
+ accumulated into a cumulative count on a base grid whose resolution is the smallest bin
+ width, and the count of each bin of each width is the difference between two cumulative
+ counts (prefix sums). In trial mode, the bins start at the given trial onsets, and the
+ cumulative count at each bin edge is found by binary search. The neurons are distributed
+ among the available cores.
+
+ The spike times can be given as a cell array, or as the name of a binary file that is
+ memory-mapped instead of read, which avoids copying large recordings. The file contains
+ the number of neurons n (uint64), the number of spikes of each neuron (n x uint64), and
+ the spike times of each neuron in turn (float64), in the byte order of the machine.
+
+ USAGE:
+
+   counts = dinidlSpikeBin(spikes,widths,range)
+   counts = dinidlSpikeBin(spikes,widths,onsets,window)
+
+ where spikes is a cell array with one vector of sorted spike times per neuron, or a file
+ name, and widths is a vector of bin widths, each of which must be a multiple of the
+ smallest one in continuous mode. In continuous mode, the bins of each width tile the
+ interval range = [tstart,tstop), and counts is a cell array with one matrix per width,
+ with one row per bin and one column per neuron. In trial mode, onsets is a vector with the
+ start of each trial, and the bins of each width tile [onset,onset+window). Then counts has
+ one array per width, with one row per trial, one column per neuron and one page per bin,
+ so that counts{k}(:,:,b) contains the population responses expected by, e.g.,
+ dinidlGaussOnline('add',...).
+
+ The code can be compiled as follows
+
+   mex -v GCC='/usr/bin/gcc-4.7' CFLAGS='$CFLAGS -fopenmp' LDFLAGS='$LDFLAGS -fopenmp' dinidlSpikeBin.c
+
+ where you should replace /usr/bin/gcc-4.7 for the appropriate folder
+ and C compiler compatible with your Matlab installation. The OpenMP flags are optional.
+ Memory mapping requires a POSIX system; elsewhere, file names produce an error and the
+ spike times must be given as a cell array.
+
+ VERSION CONTROL
+
+ V1.000 (19 Oct 2026)
+ V1.001 Memory mapping only on POSIX systems, and stricter file checks (19 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#include<mex.h>
+#include<math.h>
+#include<stdint.h>
+#include<string.h>
+#include<limits.h>
+#if defined(__unix__) || defined(__APPLE__)
+#define SPIKE_MMAP
+#include<fcntl.h>
+#include<unistd.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#endif
+
+/* Spike trains of all neurons, either borrowed from Matlab or memory-mapped from a file */
+typedef struct
+{
+    unsigned        num;
+    const double    **times;
+    size_t          *count;
+    void            *map;
+    size_t          maplen;
+} spikeTrains;
+
+void spikeTrainsFromCell(spikeTrains *tr, const mxArray *cell)
+{
+    unsigned    ind;
+
+    tr->num   = (unsigned) mxGetNumberOfElements(cell);
+    tr->times = (const double**) mxMalloc(tr->num*sizeof(double*));
+    tr->count = (size_t*) mxMalloc(tr->num*sizeof(size_t));
+    tr->map   = NULL;
+    for(ind=0; ind<tr->num; ind++)
+    {
+        if(!mxIsDouble(mxGetCell(cell,ind))) mexErrMsgTxt("Spike times must be double vectors");
+        tr->times[ind] = mxGetPr(mxGetCell(cell,ind));
+        tr->count[ind] = mxGetNumberOfElements(mxGetCell(cell,ind));
+    }
+}
+
+#ifdef SPIKE_MMAP
+void spikeTrainsFromFile(spikeTrains *tr, const char *name)
+{
+    int         fd = open(name, O_RDONLY);
+    struct stat st;
+    uint64_t    *head;
+    size_t      offset, ind;
+
+    if(fd<0) mexErrMsgTxt("Cannot open the file of spike times");
+    if(fstat(fd,&st) || st.st_size<(off_t)sizeof(uint64_t)) { close(fd); mexErrMsgTxt("Invalid file of spike times"); }
+    tr->maplen = (size_t) st.st_size;
+    tr->map    = mmap(NULL, tr->maplen, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(tr->map==MAP_FAILED) mexErrMsgTxt("Cannot map the file of spike times");
+
+    /* The counts are checked against the remaining bytes before any sum that could wrap */
+    head = (uint64_t*) tr->map;
+    if(head[0]>UINT_MAX || head[0]>=tr->maplen/sizeof(uint64_t))
+    {
+        munmap(tr->map, tr->maplen);
+        mexErrMsgTxt("Invalid file of spike times");
+    }
+    tr->num   = (unsigned) head[0];
+    offset    = (1+(size_t)tr->num)*sizeof(uint64_t);
+    tr->times = (const double**) mxMalloc(tr->num*sizeof(double*));
+    tr->count = (size_t*) mxMalloc(tr->num*sizeof(size_t));
+    for(ind=0; ind<tr->num; ind++)
+    {
+        if(head[1+ind]>(tr->maplen-offset)/sizeof(double))
+        {
+            munmap(tr->map, tr->maplen);
+            mexErrMsgTxt("Invalid file of spike times");
+        }
+        tr->count[ind] = (size_t) head[1+ind];
+        tr->times[ind] = (const double*) ((char*) tr->map + offset);
+        offset += tr->count[ind]*sizeof(double);
+    }
+    madvise(tr->map, tr->maplen, MADV_SEQUENTIAL);
+}
+#else
+void spikeTrainsFromFile(spikeTrains *tr, const char *name)
+{
+    mexErrMsgTxt("Files of spike times require memory mapping, which is not available here");
+}
+#endif
+
+void spikeTrainsFree(spikeTrains *tr)
+{
+#ifdef SPIKE_MMAP
+    if(tr->map!=NULL) munmap(tr->map, tr->maplen);
+#endif
+    mxFree(tr->times);
+    mxFree(tr->count);
+}
+
+/* Number of spikes before t in the sorted times */
+size_t spikesBefore(const double *times, size_t num, double t)
+{
+    size_t  lo = 0, hi = num, mid;
+
+    while(lo<hi)
+    {
+        mid = lo+(hi-lo)/2;
+        if(times[mid]<t) lo = mid+1; else hi = mid;
+    }
+    return lo;
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    spikeTrains tr;
+    unsigned    nw, indw;
+    long        indn;
+    double      *widths, *nbins, base = INFINITY;
+    double      **out;
+    char        *name;
+    int         trials;
+
+    if(nrhs<3) mexErrMsgTxt("Please specify the spike times, the bin widths and the range or the trial onsets");
+    trials = nrhs>3;
+    nw     = (unsigned) mxGetNumberOfElements(prhs[1]);
+    widths = mxGetPr(prhs[1]);
+    if(nw==0) mexErrMsgTxt("Please specify at least one bin width");
+    for(indw=0; indw<nw; indw++)
+    {
+        if(!(widths[indw]>0)) mexErrMsgTxt("The bin widths must be positive");
+        if(widths[indw]<base) base = widths[indw];
+    }
+
+    if(mxIsChar(prhs[0]))
+    {
+        name = mxArrayToString(prhs[0]);
+        spikeTrainsFromFile(&tr, name);
+        mxFree(name);
+    }
+    else if(mxIsCell(prhs[0]))
+        spikeTrainsFromCell(&tr, prhs[0]);
+    else
+        mexErrMsgTxt("The spike times must be a cell array or a file name");
+
+    plhs[0] = mxCreateCellMatrix(1,nw);
+    out     = (double**) mxMalloc(nw*sizeof(double*));
+    nbins   = (double*) mxMalloc(nw*sizeof(double));
+
+    if(!trials)
+    {
+        double      t0, t1;
+        size_t      nbase;
+        unsigned    *ratio = (unsigned*) mxMalloc(nw*sizeof(unsigned));
+
+        if(mxGetNumberOfElements(prhs[2])!=2) mexErrMsgTxt("The range must be [tstart,tstop]");
+        t0 = mxGetPr(prhs[2])[0];
+        t1 = mxGetPr(prhs[2])[1];
+        if(!(t1>t0)) mexErrMsgTxt("The range must satisfy tstart < tstop");
+        nbase = (size_t) floor((t1-t0)/base*(1+1E-12));
+
+        for(indw=0; indw<nw; indw++)
+        {
+            ratio[indw] = (unsigned) floor(widths[indw]/base+0.5);
+            if(fabs(ratio[indw]*base-widths[indw])>1E-9*widths[indw])
+                mexErrMsgTxt("In continuous mode, the bin widths must be multiples of the smallest one");
+            nbins[indw] = (double) (nbase/ratio[indw]);
+            mxSetCell(plhs[0], indw, mxCreateDoubleMatrix((mwSize) nbins[indw], tr.num, mxREAL));
+            out[indw] = mxGetPr(mxGetCell(plhs[0], indw));
+        }
+
+        #pragma omp parallel for schedule(dynamic)
+        for(indn=0; indn<(long)tr.num; indn++)
+        {
+            const double    *times = tr.times[indn];
+            size_t          *cum = (size_t*) malloc((nbase+1)*sizeof(size_t));
+            size_t          sp = spikesBefore(times, tr.count[indn], t0);
+            size_t          indb, nb;
+            unsigned        w;
+
+            /* Cumulative counts at the edges of the base grid, in a single pass */
+            cum[0] = 0;
+            for(indb=1; indb<=nbase; indb++)
+            {
+                cum[indb] = cum[indb-1];
+                while(sp<tr.count[indn] && times[sp]<t0+indb*base) { cum[indb]++; sp++; }
+            }
+
+            for(w=0; w<nw; w++)
+            {
+                nb = (size_t) nbins[w];
+                for(indb=0; indb<nb; indb++)
+                    out[w][indb+(size_t)indn*nb] = (double)(cum[(indb+1)*ratio[w]]-cum[indb*ratio[w]]);
+            }
+            free(cum);
+        }
+        mxFree(ratio);
+    }
+    else
+    {
+        unsigned    ntr = (unsigned) mxGetNumberOfElements(prhs[2]);
+        double      *onsets = mxGetPr(prhs[2]);
+        double      window = mxGetScalar(prhs[3]);
+        mwSize      dims[3];
+
+        if(!(window>0)) mexErrMsgTxt("The window must be positive");
+        for(indw=0; indw<nw; indw++)
+        {
+            nbins[indw] = floor(window/widths[indw]*(1+1E-12));
+            if(nbins[indw]<1) mexErrMsgTxt("The bin widths must not exceed the window");
+            dims[0] = ntr;
+            dims[1] = tr.num;
+            dims[2] = (mwSize) nbins[indw];
+            mxSetCell(plhs[0], indw, mxCreateNumericArray(3, dims, mxDOUBLE_CLASS, mxREAL));
+            out[indw] = mxGetPr(mxGetCell(plhs[0], indw));
+        }
+
+        #pragma omp parallel for schedule(dynamic)
+        for(indn=0; indn<(long)tr.num; indn++)
+        {
+            const double    *times = tr.times[indn];
+            size_t          num = tr.count[indn];
+            size_t          first, last, nb, indb;
+            unsigned        indt, w;
+
+            for(indt=0; indt<ntr; indt++)
+            {
+                /* Spikes of the trial, located once and shared by all widths */
+                first = spikesBefore(times, num, onsets[indt]);
+                last  = first + spikesBefore(times+first, num-first, onsets[indt]+window);
+                for(w=0; w<nw; w++)
+                {
+                    size_t  prev = first, next;
+
+                    nb = (size_t) nbins[w];
+                    for(indb=0; indb<nb; indb++)
+                    {
+                        next = prev + spikesBefore(times+prev, last-prev, onsets[indt]+(indb+1)*widths[w]);
+                        out[w][indt+(size_t)ntr*(indn+(size_t)tr.num*indb)] = (double)(next-prev);
+                        prev = next;
+                    }
+                }
+            }
+        }
+    }
+
+    mxFree(out);
+    mxFree(nbins);
+    spikeTrainsFree(&tr);
+}
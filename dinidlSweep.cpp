@@ -0,0 +1,287 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Computes the communication information losses depicted in Figure 4 of the aforementioned
+ publication for a sweep of points, as done by dinidlGaussThetaT, while reporting the
+ progress of the sweep and allowing it to be cancelled (see sweepRunner.hpp).
+
+ USAGE:
+
+   [di,theta,res] = dinidlSweep(par,progress,interval,nthreads,history,table,meshes,warm)
+   [chunk,cost] = dinidlSweep(par,'partition',nchunks,history)
+
+ where par is a matrix with one row [q,rho1,rho2] per point. If the function handle
+ progress is given, it is called every interval seconds (default 1) and once at the end
+ as stop = progress(prog), where prog is a struct with fields completed, total, elapsed,
+ eta (estimated seconds to finish), errsum and errmax (sum and maximum of the error
+ estimates of the finished points). If stop is true, the sweep is cancelled: the points in
+ progress finish, and no other point is started. Errors of progress (or Ctrl-C while it
+ runs) also cancel the sweep, and are thrown once the points in progress finish. The
+ number of threads is given by nthreads (default, as given by OpenMP). The outputs di and
+ theta are column vectors with the communication information loss of each point and the
+ value of theta attaining it (NaN for points not finished), and res is a struct with
+ fields done (points finished), err (error estimates), evals (evaluations of the
+ integrands), seconds (time taken by each point), elapsed and cancelled.
+
+ Points start in decreasing order of the cost predicted by the model of sweepRunner.hpp.
+ If the file name history is given, the model is fitted to the costs recorded in it, and
+ the costs of the finished points are appended to it. In the second form, the points are
+ split into nchunks chunks of similar predicted cost (e.g., for running them in different
+ machines), chunk contains the chunk of each point (from 1 to nchunks) and cost the
+ predicted number of evaluations of each point.
+
+ If the name table is given (e.g., '/dinidl'), the results are shared through that table
+ (see resultTable.hpp) with the sweeps run at the same time by other Matlab sessions or
+ Python processes of the machine. Points finished by others are taken from the table and
+ indicated in the field shared of res, and points being computed by others are awaited.
+ If the name of an existing folder meshes is given, the cubatures start from the
+ partitions of the domain stored there by previous runs with similar points, and store
+ their final partitions there. If warm is true, the cubatures of each point start from the
+ final partitions of the nearest point finished in the sweep.
+
+ The code requires no external library, and can be compiled as follows
+
+   mex -v GCC='/usr/bin/g++-4.7' CXXFLAGS='$CXXFLAGS -std=c++11 -fopenmp' LDFLAGS='$LDFLAGS -fopenmp' dinidlSweep.cpp -lrt
+
+ where you should replace /usr/bin/g++-4.7 for the appropriate folder
+ and C++ compiler compatible with your Matlab installation. The OpenMP flags are optional.
+
+ VERSION CONTROL
+
+ V1.000 (19 Oct 2026)
+ V1.001 Results shared among processes (19 Oct 2026)
+ V1.002 Stored partitions of the cubatures (19 Oct 2026)
+ V1.003 Cubatures started from neighbouring points (19 Oct 2026)
+ V1.004 Sweep stopped before errors of the progress function are thrown (19 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#include<mex.h>
+#include<cmath>
+#include<thread>
+#include "sweepRunner.hpp"
+
+/* Progress as a Matlab struct */
+mxArray *sweepProgressStruct(const SweepProgress &prog)
+{
+    const char  *fields[6] = {"completed","total","elapsed","eta","errsum","errmax"};
+    mxArray     *res = mxCreateStructMatrix(1,1,6,fields);
+
+    mxSetField(res,0,"completed",mxCreateDoubleScalar(prog.completed));
+    mxSetField(res,0,"total",    mxCreateDoubleScalar(prog.total));
+    mxSetField(res,0,"elapsed",  mxCreateDoubleScalar(prog.elapsed));
+    mxSetField(res,0,"eta",      mxCreateDoubleScalar(prog.eta));
+    mxSetField(res,0,"errsum",   mxCreateDoubleScalar(prog.errsum));
+    mxSetField(res,0,"errmax",   mxCreateDoubleScalar(prog.errmax));
+    return res;
+}
+
+/* Calls the progress function, and returns whether it asks for the sweep to stop. Errors
+   of the progress function (including Ctrl-C) are returned in err instead of thrown, so that
+   the sweep can be stopped before leaving the mex function. */
+bool sweepCallback(const mxArray *fun, const SweepProgress &prog, mxArray **err)
+{
+    mxArray     *in[2], *out[1] = {NULL};
+    bool        stop;
+
+    in[0] = (mxArray*) fun;
+    in[1] = sweepProgressStruct(prog);
+    *err = mexCallMATLABWithTrap(1, out, 2, in, "feval");
+    stop = *err==NULL && out[0]!=NULL && !mxIsEmpty(out[0]) && mxGetScalar(out[0])!=0;
+    mxDestroyArray(in[1]);
+    if(*err==NULL && out[0]!=NULL) mxDestroyArray(out[0]);
+    return stop;
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    const char      *fields[7] = {"done","err","evals","seconds","elapsed","cancelled","shared"};
+    const mxArray   *fun = NULL;
+    mxArray         *err = NULL, *msg;
+    char            *history = NULL, *tabname, *meshdir;
+    ResultTable     table;
+    double          interval = 1;
+    int             nthreads = 0;
+    size_t          npt, ind;
+    double          *val, *par;
+    std::vector<unsigned char>  done;
+    SweepProgress   prog;
+
+    if(nrhs<1 || mxGetN(prhs[0])!=3) mexErrMsgTxt("Please specify the parameters as rows [q,rho1,rho2]");
+    npt = mxGetM(prhs[0]);
+    val = mxGetPr(prhs[0]);
+    par = (double*) mxMalloc((3*npt+1)*sizeof(double));
+    for(ind=0; ind<npt; ind++)
+    {
+        par[3*ind]   = val[ind];
+        par[3*ind+1] = val[ind+npt];
+        par[3*ind+2] = val[ind+2*npt];
+        if(!(par[3*ind]>0 && par[3*ind]<1) || !(fabs(par[3*ind+1])<1) || !(fabs(par[3*ind+2])<1))
+            mexErrMsgTxt("The parameters must satisfy 0<q<1, |rho1|<1 and |rho2|<1");
+    }
+
+    /* Partition into chunks of similar predicted cost */
+    if(nrhs>1 && mxIsChar(prhs[1]))
+    {
+        SweepCostModel          model;
+        std::vector<unsigned>   chunk(npt);
+        std::vector<double>     cost(npt);
+        unsigned                nchunk;
+
+        if(nrhs<3) mexErrMsgTxt("Please specify the number of chunks");
+        nchunk = (unsigned) mxGetScalar(prhs[2]);
+        if(nchunk<1) mexErrMsgTxt("The number of chunks must be positive");
+        if(nrhs>3 && mxIsChar(prhs[3]))
+        {
+            history = mxArrayToString(prhs[3]);
+            model.load(history);
+            mxFree(history);
+        }
+        for(ind=0; ind<npt; ind++) cost[ind] = model.predict(par+3*ind);
+        sweepPartition(cost.data(), npt, nchunk, chunk.data());
+        plhs[0] = mxCreateDoubleMatrix(npt,1,mxREAL);
+        for(ind=0; ind<npt; ind++) mxGetPr(plhs[0])[ind] = chunk[ind]+1;
+        if(nlhs>1)
+        {
+            plhs[1] = mxCreateDoubleMatrix(npt,1,mxREAL);
+            std::copy(cost.begin(), cost.end(), mxGetPr(plhs[1]));
+        }
+        mxFree(par);
+        return;
+    }
+
+    if(nrhs>1 && !mxIsEmpty(prhs[1])) fun = prhs[1];
+    if(nrhs>2 && !mxIsEmpty(prhs[2])) interval = mxGetScalar(prhs[2]);
+    if(nrhs>3 && !mxIsEmpty(prhs[3])) nthreads = (int) mxGetScalar(prhs[3]);
+    if(nrhs>4 && mxIsChar(prhs[4])) history = mxArrayToString(prhs[4]);
+    if(!(interval>0)) mexErrMsgTxt("The interval between calls to the progress function must be positive");
+
+    SweepRunner     sweep(par, npt);
+    SweepCostModel  model;
+
+    if(nrhs>5 && mxIsChar(prhs[5]))
+    {
+        tabname = mxArrayToString(prhs[5]);
+        if(table.open(tabname, 1 << 16))
+            sweep.setTable(&table);
+        else
+            mexWarnMsgTxt("The result table could not be opened, and the results will not be shared");
+        mxFree(tabname);
+    }
+    if(nrhs>6 && mxIsChar(prhs[6]))
+    {
+        meshdir = mxArrayToString(prhs[6]);
+        sweep.setMeshDir(meshdir);
+        mxFree(meshdir);
+    }
+    if(nrhs>7 && !mxIsEmpty(prhs[7])) sweep.setWarmStart(mxGetScalar(prhs[7])!=0);
+
+    /* Points start in decreasing order of predicted cost */
+    if(history!=NULL) model.load(history);
+    sweep.setCost(model);
+
+    /* The Matlab API is not thread safe, so the sweep runs in a separate thread while this
+       one calls the progress function */
+    if(fun==NULL)
+        sweep.run(nthreads);
+    else
+    {
+        std::thread worker(&SweepRunner::run, &sweep, nthreads);
+
+        do
+        {
+            std::this_thread::sleep_for(std::chrono::duration<double>(interval));
+            prog = sweep.progress();
+            if(prog.running && (sweepCallback(fun, prog, &err) || err!=NULL)) sweep.cancel();
+        }
+        while(prog.running && err==NULL);
+        worker.join();
+        if(err==NULL) sweepCallback(fun, sweep.progress(), &err);
+
+        /* The error is thrown only once the worker has returned */
+        if(err!=NULL)
+        {
+            if(history!=NULL) mxFree(history);
+            mxFree(par);
+            msg = mxGetProperty(err, 0, "message");
+            mexErrMsgIdAndTxt("dinidlSweep:progress", "The progress function failed: %s",
+                              msg!=NULL && mxIsChar(msg) ? mxArrayToString(msg) : "unknown error");
+        }
+    }
+    prog = sweep.progress();
+    if(history!=NULL)
+    {
+        SweepCostModel  update;
+
+        sweep.record(update);
+        if(!update.save(history)) mexWarnMsgTxt("The history of costs could not be saved");
+        mxFree(history);
+    }
+
+    plhs[0] = mxCreateDoubleMatrix(npt,1,mxREAL);
+    std::copy(sweep.losses().begin(), sweep.losses().end(), mxGetPr(plhs[0]));
+    if(nlhs>1)
+    {
+        plhs[1] = mxCreateDoubleMatrix(npt,1,mxREAL);
+        std::copy(sweep.thetas().begin(), sweep.thetas().end(), mxGetPr(plhs[1]));
+    }
+    if(nlhs>2)
+    {
+        plhs[2] = mxCreateStructMatrix(1,1,7,fields);
+        mxSetField(plhs[2],0,"done",   mxCreateLogicalMatrix(npt,1));
+        mxSetField(plhs[2],0,"err",    mxCreateDoubleMatrix(npt,1,mxREAL));
+        mxSetField(plhs[2],0,"evals",  mxCreateDoubleMatrix(npt,1,mxREAL));
+        mxSetField(plhs[2],0,"seconds",mxCreateDoubleMatrix(npt,1,mxREAL));
+        mxSetField(plhs[2],0,"elapsed",mxCreateDoubleScalar(prog.elapsed));
+        mxSetField(plhs[2],0,"cancelled",mxCreateLogicalScalar(prog.cancelled));
+        mxSetField(plhs[2],0,"shared", mxCreateLogicalMatrix(npt,1));
+        for(ind=0; ind<npt; ind++)
+        {
+            mxGetLogicals(mxGetField(plhs[2],0,"done"))[ind] = sweep.finished()[ind];
+            mxGetPr(mxGetField(plhs[2],0,"err"))[ind]     = sweep.errors()[ind];
+            mxGetPr(mxGetField(plhs[2],0,"evals"))[ind]   = (double)sweep.evaluations()[ind];
+            mxGetPr(mxGetField(plhs[2],0,"seconds"))[ind] = sweep.times()[ind];
+            mxGetLogicals(mxGetField(plhs[2],0,"shared"))[ind] = sweep.fromTable()[ind];
+        }
+    }
+    mxFree(par);
+}
@@ -0,0 +1,295 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Integrands of Figures 4 and 7 as classes for the templated cubature of
+ templateCubature.hpp and for the benchmarks. Their parameters are fixed when the classes
+ are constructed, so that the terms that do not depend on the responses are computed only
+ once.
+
+ FigLoss can start each cubature from the partitions of the domain reached by the previous
+ one, kept in a FigMesh, which can be stored in files for later runs with similar
+ parameters.
+
+ This file is included by the files that need it, and requires no external library.
+
+ VERSION CONTROL
+
+ V1.000 (19 Oct 2026)
+ V1.001 Cubatures of FigLoss started from stored partitions (19 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#ifndef FIGINTEGRANDS_HPP
+#define FIGINTEGRANDS_HPP
+
+#include<cmath>
+#include<cstdio>
+#include<string>
+#include<thread>
+#include<functional>
+#include<random>
+#include<atomic>
+#include "templateCubature.hpp"
+
+/* Integrand of dinidlGaussTheta for D dimensions, where the stimuli have means -1 and 1
+   along all dimensions, prior probabilities p1 and p2, and correlation coefficients rho1
+   and rho2 (only used when D = 2). The NI decoder with parameter th assumes independent
+   unit-variance responses. */
+template<unsigned D>
+class FigIntegrand
+{
+public:
+    FigIntegrand(double p1, double p2, double rho1, double rho2, double th)
+    {
+        double  a1 = 1.0/(1.0-rho1*rho1);
+        double  a2 = 1.0/(1.0-rho2*rho2);
+
+        ln1 = log(p1) + (D==2 ? 0.5*log(a1) : 0) - 0.5*D*log(2*M_PI);
+        ln2 = log(p2) + (D==2 ? 0.5*log(a2) : 0) - 0.5*D*log(2*M_PI);
+        lp1 = log(p1);
+        lp2 = log(p2);
+        sq1 = D==2 ? a1 : 1;
+        sq2 = D==2 ? a2 : 1;
+        pr1 = D==2 ? rho1*a1 : 0;
+        pr2 = D==2 ? rho2*a2 : 0;
+        theta = th;
+    }
+
+    double operator()(const double *x) const
+    {
+        double      sa = 0, sb = 0, pa = 1, pb = 1;
+        double      lps1, lps2, lpi1, lpi2, ps1, ps2, val;
+        unsigned    ind;
+
+        for(ind=0; ind<D; ind++)
+        {
+            sa -= 0.5*(x[ind]+1)*(x[ind]+1);
+            sb -= 0.5*(x[ind]-1)*(x[ind]-1);
+            pa *= x[ind]+1;
+            pb *= x[ind]-1;
+        }
+        lps1 = ln1 + sq1*sa + (D==2 ? pr1*pa : 0);
+        lps2 = ln2 + sq2*sb + (D==2 ? pr2*pb : 0);
+        lpi1 = lp1 + theta*sa;
+        lpi2 = lp2 + theta*sb;
+        ps1  = exp(lps1);
+        ps2  = exp(lps2);
+        val  = ps1*(lps1-lpi1) + ps2*(lps2-lpi2) - (ps1+ps2)*log((ps1+ps2)/(exp(lpi1)+exp(lpi2)));
+        return std::isfinite(val) ? val : 0;
+    }
+
+private:
+    double  ln1, ln2, lp1, lp2, sq1, sq2, pr1, pr2, theta;
+};
+
+/* Partitions of the domains of the two-dimensional and one-dimensional integrals of
+   FigLoss */
+struct FigMesh
+{
+    std::vector< CubatureRegion<2> >    m2D;
+    std::vector< CubatureRegion<1> >    m1D;
+
+    /* Writes both partitions to file, through a temporary file that is then renamed so that
+       other processes never read a partial file. The temporary file is named after the
+       thread, a random token drawn once per process and a counter, since several threads
+       and processes may save the same file at once. Returns 0 on failure. */
+    int save(const char *file) const
+    {
+        static const unsigned       token = std::random_device()();
+        static std::atomic<unsigned> count(0);
+        char        suffix[64];
+        std::string tmp;
+        FILE        *fid;
+        int         ok;
+
+        snprintf(suffix, sizeof(suffix), ".%x.%zx.%u.tmp", token,
+                 std::hash<std::thread::id>()(std::this_thread::get_id()), count++);
+        tmp = std::string(file) + suffix;
+        fid = fopen(tmp.c_str(), "w");
+
+        if(fid==NULL) return 0;
+        ok = cubatureWrite<2>(fid, m2D) && cubatureWrite<1>(fid, m1D);
+        ok = fclose(fid)==0 && ok;
+        ok = ok && std::rename(tmp.c_str(), file)==0;
+        if(!ok) std::remove(tmp.c_str());
+        return ok;
+    }
+
+    /* Whether the regions lie inside [-5,5]^D and their volumes add up to that of the
+       domain, as for any partition of it. Empty partitions are accepted. */
+    template<unsigned D>
+    static int covers(const std::vector< CubatureRegion<D> > &reg)
+    {
+        double      vol = 0, now, dom = std::pow(10.0, (double)D);
+        size_t      ind;
+        unsigned    k;
+
+        for(ind=0; ind<reg.size(); ind++)
+        {
+            for(k=0, now=1; k<D; k++)
+            {
+                if(!(std::fabs(reg[ind].c[k])+reg[ind].h[k]<=5*(1+1E-12))) return 0;
+                now *= 2*reg[ind].h[k];
+            }
+            vol += now;
+        }
+        return reg.empty() || std::fabs(vol-dom)<=1E-9*dom;
+    }
+
+    /* Reads both partitions from file. Returns 0, leaving them empty, on failure or if they
+       are not partitions of the domains. */
+    int load(const char *file)
+    {
+        FILE    *fid = fopen(file, "r");
+        int     ok;
+
+        m2D.clear();
+        m1D.clear();
+        if(fid==NULL) return 0;
+        ok = cubatureRead<2>(fid, m2D) && cubatureRead<1>(fid, m1D);
+        ok = ok && covers<2>(m2D) && covers<1>(m1D);
+        fclose(fid);
+        if(!ok)
+        {
+            m2D.clear();
+            m1D.clear();
+        }
+        return ok;
+    }
+
+    /* Reflects the partitions through the origin, which maps the partitions of [q,rho1,rho2]
+       onto those of [1-q,rho2,rho1] */
+    void mirror()
+    {
+        size_t  ind;
+
+        for(ind=0; ind<m2D.size(); ind++)
+        {
+            m2D[ind].c[0] = -m2D[ind].c[0];
+            m2D[ind].c[1] = -m2D[ind].c[1];
+        }
+        for(ind=0; ind<m1D.size(); ind++) m1D[ind].c[0] = -m1D[ind].c[0];
+    }
+};
+
+/* Communication information loss of Figure 4 as a function of theta. The number of
+   evaluations of the integrands and the error estimate of the last loss are recorded. If
+   mesh is given, each cubature starts from the partition in mesh, if not empty, and leaves
+   its final partition there. */
+class FigLoss
+{
+public:
+    FigLoss(const double *par, FigMesh *mesh = NULL) :
+        q(par[0]), rho1(par[1]), rho2(par[2]), mesh(mesh), neval(0), errval(0) {}
+
+    double operator()(double th) const
+    {
+        const double        xmin[2] = {-5,-5};
+        const double        xmax[2] = {5,5};
+        FigIntegrand<2>     f2D(q, 1-q, rho1, rho2, th);
+        FigIntegrand<1>     f1D(1-q, q, 0, 0, th);
+        Cubature<2, FigIntegrand<2> >   cub2D(f2D);
+        Cubature<1, FigIntegrand<1> >   cub1D(f1D);
+        double              dival2D, dival1D, err2D, err1D;
+
+        if(mesh!=NULL && !mesh->m2D.empty())
+            cub2D.integrate(mesh->m2D, 1000, 1E-6, 1E-3, dival2D, err2D);
+        else
+            cub2D.integrate(xmin, xmax, 1000, 1E-6, 1E-3, dival2D, err2D);
+        if(mesh!=NULL && !mesh->m1D.empty())
+            cub1D.integrate(mesh->m1D, 1000, 1E-6, 1E-3, dival1D, err1D);
+        else
+            cub1D.integrate(xmin, xmax, 1000, 1E-6, 1E-3, dival1D, err1D);
+        if(mesh!=NULL)
+        {
+            mesh->m2D = cub2D.regions();
+            mesh->m1D = cub1D.regions();
+        }
+        neval  += cub2D.evaluations() + cub1D.evaluations();
+        errval  = err2D + err1D;
+        return dival1D+dival2D;
+    }
+
+    /* Number of evaluations of the integrands so far */
+    size_t evaluations() const { return neval; }
+
+    /* Error estimate of the last loss */
+    double error() const { return errval; }
+
+private:
+    double          q, rho1, rho2;
+    FigMesh         *mesh;
+    mutable size_t  neval;
+    mutable double  errval;
+};
+
+/* Integrand of the descriptive (th = 1) and communication information losses of Figure 7c
+   in Fig7code.py, as a function of x = [x,y,q,rho1,rho2] */
+class Fig7Integrand
+{
+public:
+    Fig7Integrand(double th) : theta(th) {}
+
+    double operator()(const double *x) const
+    {
+        double  x1 = x[0]+1, y1 = x[1]+1, xpy1 = x1*x1+y1*y1;
+        double  x2 = x[0]-1, y2 = x[1]-1, xpy2 = x2*x2+y2*y2;
+        double  det1 = 1-x[3]*x[3];
+        double  det2 = 1-x[4]*x[4];
+        double  k1 = 0.5/M_PI*x[2];
+        double  k2 = 0.5/M_PI*(1-x[2]);
+        double  prs1 = k1/sqrt(det1)*exp((-0.5*xpy1+x[3]*x1*y1)/det1);
+        double  prs2 = k2/sqrt(det2)*exp((-0.5*xpy2+x[4]*x2*y2)/det2);
+        double  pni1 = k1*exp(-0.5*theta*xpy1);
+        double  pni2 = k2*exp(-0.5*theta*xpy2);
+        double  pr = prs1+prs2, pni = pni1+pni2, val = 0;
+
+        if(prs1>0) val += prs1*log(prs1/pr*pni/pni1);
+        if(prs2>0) val += prs2*log(prs2/pr*pni/pni2);
+        return std::isfinite(val) ? val : 0;
+    }
+
+private:
+    double  theta;
+};
+
+#endif
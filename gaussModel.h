@@ -0,0 +1,576 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Gaussian population models for two stimuli, and the quadratic forms giving their true and
+ NI log-likelihood ratios (see llrTable.h). Includes the closed-form characteristic
+ function of the pair of log-likelihood ratios given each stimulus, and its inversion on a
+ grid through an FFT.
+
+ This file is included by the mex-files that need it, and requires the following library
+
+ - GSL (https://www.gnu.org/software/gsl/)
+
+ VERSION CONTROL
+
+ V1.000 (18 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#ifndef GAUSSMODEL_H
+#define GAUSSMODEL_H
+
+#include<mex.h>
+#include<math.h>
+#include<complex.h>
+#include<string.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_eigen.h>
+#include "llrTable.h"
+
+/* Population whose responses to the stimuli s1 (probability q) and s2 (probability 1-q)
+   have Gaussian distributions with means mu[s] and covariance matrices C[s]. All matrices
+   are stored row-major. */
+typedef struct
+{
+    unsigned    d;
+    double      q;
+    double      *mu[2];
+    double      *C[2];
+    double      *L[2];          /* Cholesky factors of C[s] */
+    double      logdet[2];
+    /* lam (f=0) and ell (f=1) are the quadratic forms x'A[f]x + b[f]'x + c[f] */
+    double      *A[2];
+    double      *b[2];
+    double      c[2];
+    /* The same forms in the whitened responses z of stimulus s, x = mu[s] + L[s]*z */
+    double      *KA[2][2];
+    double      *beta[2][2];
+    double      gamma[2][2];
+} gaussModel;
+
+/* Lower Cholesky factor of the d x d matrix C. Returns 0 if C is not positive definite. */
+int choleskyDecomp(double *L, const double *C, unsigned d)
+{
+    unsigned    i, j, k;
+    double      sum;
+
+    memset(L, 0, (size_t)d*d*sizeof(double));
+    for(j=0; j<d; j++)
+    {
+        sum = C[j*d+j];
+        for(k=0; k<j; k++) sum -= L[j*d+k]*L[j*d+k];
+        if(!(sum>0)) return 0;
+        L[j*d+j] = sqrt(sum);
+        for(i=j+1; i<d; i++)
+        {
+            sum = C[i*d+j];
+            for(k=0; k<j; k++) sum -= L[i*d+k]*L[j*d+k];
+            L[i*d+j] = sum/L[j*d+j];
+        }
+    }
+    return 1;
+}
+
+/* Appends a row to the lower Cholesky factor L of a d x d matrix, stored row-major with
+   leading dimension ld, so that it becomes the factor of the matrix bordered by the column
+   c of length d+1. Returns 0 if the bordered matrix is not positive definite. */
+int choleskyAppend(double *L, unsigned ld, unsigned d, const double *c)
+{
+    unsigned    i, k;
+    double      sum, diag = c[d];
+
+    for(i=0; i<d; i++)
+    {
+        sum = c[i];
+        for(k=0; k<i; k++) sum -= L[i*ld+k]*L[d*ld+k];
+        L[d*ld+i] = sum/L[i*ld+i];
+        diag -= L[d*ld+i]*L[d*ld+i];
+    }
+    if(!(diag>0)) return 0;
+    L[d*ld+d] = sqrt(diag);
+    for(k=d+1; k<ld; k++) L[d*ld+k] = 0;
+    return 1;
+}
+
+/* Inverse of L*L' given the lower Cholesky factor L */
+void choleskyInverse(double *P, const double *L, unsigned d)
+{
+    unsigned    i, j, k;
+    double      *Linv = (double*) calloc((size_t)d*d, sizeof(double));
+    double      sum;
+
+    for(j=0; j<d; j++)
+    {
+        Linv[j*d+j] = 1/L[j*d+j];
+        for(i=j+1; i<d; i++)
+        {
+            sum = 0;
+            for(k=j; k<i; k++) sum -= L[i*d+k]*Linv[k*d+j];
+            Linv[i*d+j] = sum/L[i*d+i];
+        }
+    }
+    for(i=0; i<d; i++)
+        for(j=0; j<=i; j++)
+        {
+            sum = 0;
+            for(k=i; k<d; k++) sum += Linv[k*d+i]*Linv[k*d+j];
+            P[i*d+j] = P[j*d+i] = sum;
+        }
+    free(Linv);
+}
+
+/* Computes all quantities derived from q, mu, C and the Cholesky factors L of C */
+void gaussModelInitFactored(gaussModel *pop)
+{
+    unsigned    d = pop->d;
+    unsigned    s, f, i, j, k;
+    double      *P = (double*) malloc((size_t)d*d*sizeof(double));
+    double      *g = (double*) malloc(2*(size_t)d*sizeof(double));
+    double      *AL = g + d;
+    double      sum;
+    double      lnorm;
+
+    for(f=0; f<2; f++)
+    {
+        memset(pop->A[f], 0, (size_t)d*d*sizeof(double));
+        memset(pop->b[f], 0, (size_t)d*sizeof(double));
+        pop->c[f] = 0;
+    }
+
+    for(s=0; s<2; s++)
+    {
+        pop->logdet[s] = 0;
+        for(i=0; i<d; i++) pop->logdet[s] += 2*log(pop->L[s][i*d+i]);
+
+        /* log N(x;mu,C) = -x'Px/2 + (P*mu)'x - mu'P*mu/2 - logdet/2 - d*log(2*pi)/2 */
+        choleskyInverse(P, pop->L[s], d);
+        lnorm = -0.5*pop->logdet[s];
+        for(i=0; i<d; i++)
+        {
+            sum = 0;
+            for(j=0; j<d; j++)
+            {
+                pop->A[0][i*d+j] += (s==0 ? -0.5 : 0.5)*P[i*d+j];
+                sum += P[i*d+j]*pop->mu[s][j];
+            }
+            pop->b[0][i] += (s==0 ? 1 : -1)*sum;
+            lnorm -= 0.5*sum*pop->mu[s][i];
+        }
+        pop->c[0] += (s==0 ? 1 : -1)*lnorm;
+
+        /* The NI likelihood keeps only the variances */
+        lnorm = 0;
+        for(i=0; i<d; i++)
+        {
+            sum = 1/pop->C[s][i*d+i];
+            pop->A[1][i*d+i] += (s==0 ? -0.5 : 0.5)*sum;
+            pop->b[1][i]     += (s==0 ? 1 : -1)*sum*pop->mu[s][i];
+            lnorm -= 0.5*(log(pop->C[s][i*d+i]) + sum*pop->mu[s][i]*pop->mu[s][i]);
+        }
+        pop->c[1] += (s==0 ? 1 : -1)*lnorm;
+    }
+
+    /* Forms in the whitened responses: K = L'AL, beta = L'(2A*mu+b), gamma = mu'A*mu+b'mu+c */
+    for(s=0; s<2; s++)
+        for(f=0; f<2; f++)
+        {
+            for(i=0; i<d; i++)
+            {
+                sum = pop->b[f][i];
+                for(j=0; j<d; j++) sum += 2*pop->A[f][i*d+j]*pop->mu[s][j];
+                g[i] = sum;
+            }
+            pop->gamma[s][f] = pop->c[f];
+            for(i=0; i<d; i++)
+            {
+                sum = 0.5*(g[i]+pop->b[f][i]);
+                pop->gamma[s][f] += sum*pop->mu[s][i];
+            }
+            for(j=0; j<d; j++)
+            {
+                sum = 0;
+                for(i=j; i<d; i++) sum += pop->L[s][i*d+j]*g[i];
+                pop->beta[s][f][j] = sum;
+            }
+            for(j=0; j<d; j++)
+            {
+                /* AL = A * (column j of L) */
+                for(i=0; i<d; i++)
+                {
+                    sum = 0;
+                    for(k=j; k<d; k++) sum += pop->A[f][i*d+k]*pop->L[s][k*d+j];
+                    AL[i] = sum;
+                }
+                for(i=0; i<=j; i++)
+                {
+                    sum = 0;
+                    for(k=i; k<d; k++) sum += pop->L[s][k*d+i]*AL[k];
+                    pop->KA[s][f][i*d+j] = pop->KA[s][f][j*d+i] = sum;
+                }
+            }
+        }
+
+    free(P);
+    free(g);
+}
+
+/* Computes all quantities derived from q, mu and C. Returns 0 if some covariance matrix
+   is not positive definite. */
+int gaussModelInit(gaussModel *pop)
+{
+    unsigned    s;
+
+    for(s=0; s<2; s++)
+        if(!choleskyDecomp(pop->L[s], pop->C[s], pop->d)) return 0;
+    gaussModelInitFactored(pop);
+    return 1;
+}
+
+gaussModel *gaussModelAlloc(unsigned d)
+{
+    gaussModel  *pop = (gaussModel*) malloc(sizeof(gaussModel));
+    size_t      dd = (size_t)d*d;
+    double      *mem = (double*) calloc(10*dd+8*(size_t)d, sizeof(double));
+    unsigned    s, f;
+
+    pop->d = d;
+    for(s=0; s<2; s++)
+    {
+        pop->C[s]  = mem; mem += dd;
+        pop->L[s]  = mem; mem += dd;
+        pop->A[s]  = mem; mem += dd;
+        pop->mu[s] = mem; mem += d;
+        pop->b[s]  = mem; mem += d;
+        for(f=0; f<2; f++)
+        {
+            pop->KA[s][f]   = mem; mem += dd;
+            pop->beta[s][f] = mem; mem += d;
+        }
+    }
+    return pop;
+}
+
+void gaussModelFree(gaussModel *pop)
+{
+    if(pop==NULL) return;
+    free(pop->C[0]);
+    free(pop);
+}
+
+/* Reads the population ind of the struct array pops, with fields q, mu1, mu2, C1 and C2 */
+gaussModel *gaussModelFromStruct(const mxArray *pops, mwIndex ind)
+{
+    const char  *fmu[2] = {"mu1","mu2"};
+    const char  *fC[2]  = {"C1","C2"};
+    mxArray     *fld;
+    gaussModel  *pop;
+    unsigned    d;
+    unsigned    s, i, j;
+    double      *val;
+
+    if(!mxIsStruct(pops)) mexErrMsgTxt("Populations must be given as a struct with fields q, mu1, mu2, C1 and C2");
+    fld = mxGetField(pops, ind, "mu1");
+    if(fld==NULL || mxIsEmpty(fld)) mexErrMsgTxt("Missing field mu1");
+    d = (unsigned) mxGetNumberOfElements(fld);
+
+    pop = gaussModelAlloc(d);
+    fld = mxGetField(pops, ind, "q");
+    if(fld==NULL || mxIsEmpty(fld)) mexErrMsgTxt("Missing field q");
+    pop->q = mxGetScalar(fld);
+    if(!(pop->q>0 && pop->q<1)) mexErrMsgTxt("The value of q must be greater than zero and less than unity");
+
+    for(s=0; s<2; s++)
+    {
+        fld = mxGetField(pops, ind, fmu[s]);
+        if(fld==NULL || mxGetNumberOfElements(fld)!=d) mexErrMsgTxt("The means must have the same number of neurons");
+        val = mxGetPr(fld);
+        for(i=0; i<d; i++) pop->mu[s][i] = val[i];
+
+        fld = mxGetField(pops, ind, fC[s]);
+        if(fld==NULL || mxGetM(fld)!=d || mxGetN(fld)!=d) mexErrMsgTxt("The covariance matrices must be square and match the means");
+        val = mxGetPr(fld);
+        for(i=0; i<d; i++)
+            for(j=0; j<d; j++)
+                pop->C[s][i*d+j] = 0.5*(val[i+d*j]+val[j+d*i]);
+    }
+
+    if(!gaussModelInit(pop)) mexErrMsgTxt("The covariance matrices must be positive definite");
+    return pop;
+}
+
+/* Log-likelihood ratios of the response x */
+void gaussModelLLR(const gaussModel *pop, const double *x, double *lam, double *ell)
+{
+    unsigned    d = pop->d;
+    unsigned    i, j;
+    double      sum;
+    double      val[2];
+    unsigned    f;
+
+    for(f=0; f<2; f++)
+    {
+        val[f] = pop->c[f];
+        for(i=0; i<d; i++)
+        {
+            sum = pop->b[f][i];
+            for(j=0; j<d; j++) sum += pop->A[f][i*d+j]*x[j];
+            val[f] += sum*x[i];
+        }
+    }
+    *lam = val[0];
+    *ell = val[1];
+}
+
+/* Mean and variance of lam (f=0) or ell (f=1) given the stimulus s */
+void gaussModelMoments(const gaussModel *pop, unsigned s, unsigned f, double *mean, double *var)
+{
+    unsigned    d = pop->d;
+    unsigned    i, j;
+    double      tr = 0;
+    double      tr2 = 0;
+    double      lin = 0;
+
+    for(i=0; i<d; i++)
+    {
+        tr  += pop->KA[s][f][i*d+i];
+        lin += pop->beta[s][f][i]*pop->beta[s][f][i];
+        for(j=0; j<d; j++) tr2 += pop->KA[s][f][i*d+j]*pop->KA[s][f][i*d+j];
+    }
+    *mean = pop->gamma[s][f] + tr;
+    *var  = 2*tr2 + lin;
+}
+
+/* Workspace for evaluating characteristic functions */
+typedef struct
+{
+    gsl_matrix                  *K;
+    gsl_matrix                  *V;
+    gsl_vector                  *ev;
+    gsl_eigen_symmv_workspace   *ws;
+} gaussCFWork;
+
+gaussCFWork *gaussCFWorkAlloc(unsigned d)
+{
+    gaussCFWork *work = (gaussCFWork*) malloc(sizeof(gaussCFWork));
+    work->K  = gsl_matrix_alloc(d,d);
+    work->V  = gsl_matrix_alloc(d,d);
+    work->ev = gsl_vector_alloc(d);
+    work->ws = gsl_eigen_symmv_alloc(d);
+    return work;
+}
+
+void gaussCFWorkFree(gaussCFWork *work)
+{
+    gsl_matrix_free(work->K);
+    gsl_matrix_free(work->V);
+    gsl_vector_free(work->ev);
+    gsl_eigen_symmv_free(work->ws);
+    free(work);
+}
+
+/* Characteristic function E[exp(i*(t0*lam+t1*ell))] given the stimulus s. In the whitened
+   responses, t0*lam+t1*ell = z'Kz + beta'z + gamma, and, along the eigenvectors of K,
+   E[exp(i*(k*u^2+b*u))] = exp(-b^2/(2*(1-2ik)))/sqrt(1-2ik) for standard normal u. */
+double complex gaussModelCF(const gaussModel *pop, unsigned s, double t0, double t1, gaussCFWork *work)
+{
+    unsigned        d = pop->d;
+    unsigned        i, j;
+    double          bnow;
+    double complex  onemik;
+    double complex  lcf = I*(t0*pop->gamma[s][0]+t1*pop->gamma[s][1]);
+
+    for(i=0; i<d; i++)
+        for(j=0; j<d; j++)
+            gsl_matrix_set(work->K, i, j, t0*pop->KA[s][0][i*d+j]+t1*pop->KA[s][1][i*d+j]);
+    gsl_eigen_symmv(work->K, work->ev, work->V, work->ws);
+
+    for(j=0; j<d; j++)
+    {
+        bnow = 0;
+        for(i=0; i<d; i++)
+            bnow += gsl_matrix_get(work->V,i,j)*(t0*pop->beta[s][0][i]+t1*pop->beta[s][1][i]);
+        onemik = 1 - 2*I*gsl_vector_get(work->ev,j);
+        lcf   -= 0.5*clog(onemik) + 0.5*bnow*bnow/onemik;
+    }
+    return cexp(lcf);
+}
+
+/* Frequency of the index k of an FFT of size n with spacing dt */
+static inline double gaussFreq(unsigned k, unsigned n, double dt)
+{
+    return (k<=n/2 ? (double)k : (double)k-n)*dt;
+}
+
+/* Sets the window of the grid so that it covers 16 standard deviations around the means of
+   (lam,ell) given each stimulus, with mean[s][f] and var[s][f] as in gaussModelMoments */
+void gaussModelWindow(llrGrid *grid, double mean[2][2], double var[2][2])
+{
+    unsigned    s, f;
+    double      lo, hi;
+
+    for(f=0; f<2; f++)
+    {
+        lo = INFINITY;
+        hi = -INFINITY;
+        for(s=0; s<2; s++)
+        {
+            if(mean[s][f]-16*sqrt(var[s][f])<lo) lo = mean[s][f]-16*sqrt(var[s][f]);
+            if(mean[s][f]+16*sqrt(var[s][f])>hi) hi = mean[s][f]+16*sqrt(var[s][f]);
+        }
+        if(hi-lo<1E-6) { lo -= 0.5; hi += 0.5; }
+        grid->lo[f] = lo;
+        grid->h[f]  = (hi-lo)/(grid->n[f]-1);
+    }
+}
+
+/* Multiplies the values of the grid, taken as characteristic functions of (lam,ell) at the
+   frequencies of the FFT of the window, by the characteristic function of the population
+   raised to the power pw. This accounts for pw independent copies of the population
+   encoding the same stimulus, whose log-likelihood ratios add. Only half of the frequencies
+   are computed, since cf(-t) = conj(cf(t)). */
+void gaussModelCFGrid(const gaussModel *pop, llrGrid *grid, unsigned pw)
+{
+    unsigned    n0 = grid->n[0];
+    unsigned    n1 = grid->n[1];
+    double      dt0 = 2*M_PI/(n0*grid->h[0]);
+    double      dt1 = 2*M_PI/(n1*grid->h[1]);
+    long        k0;
+
+    #pragma omp parallel for schedule(dynamic)
+    for(k0=0; k0<=(long)n0/2; k0++)
+    {
+        gaussCFWork     *work = gaussCFWorkAlloc(pop->d);
+        unsigned        k1, sn;
+        size_t          ind, mir;
+        double          t0, t1;
+        double complex  val;
+
+        for(k1=0; k1<n1; k1++)
+        {
+            if((k0==0 || k0==(long)n0/2) && k1>n1/2) continue;
+            t0  = gaussFreq(k0, n0, dt0);
+            t1  = gaussFreq(k1, n1, dt1);
+            ind = (size_t)k0*n1+k1;
+            mir = (size_t)((n0-k0)%n0)*n1+(n1-k1)%n1;
+            for(sn=0; sn<2; sn++)
+            {
+                val  = gaussModelCF(pop, sn, t0, t1, work);
+                if(pw!=1) val = cpow(val, pw);
+                val *= grid->val[sn][2*ind] + I*grid->val[sn][2*ind+1];
+                grid->val[sn][2*ind]   = creal(val);
+                grid->val[sn][2*ind+1] = cimag(val);
+                if(mir!=ind)
+                {
+                    grid->val[sn][2*mir]   = creal(val);
+                    grid->val[sn][2*mir+1] = -cimag(val);
+                }
+            }
+        }
+        gaussCFWorkFree(work);
+    }
+}
+
+/* Sets all characteristic functions of the grid to one, which is the characteristic
+   function of (lam,ell) = (0,0) */
+void gaussModelCFOne(llrGrid *grid)
+{
+    size_t      ind;
+    size_t      num = (size_t)grid->n[0]*grid->n[1];
+
+    for(ind=0; ind<num; ind++)
+    {
+        grid->val[0][2*ind] = grid->val[1][2*ind] = 1;
+        grid->val[0][2*ind+1] = grid->val[1][2*ind+1] = 0;
+    }
+}
+
+/* Turns the characteristic functions on the grid into the probabilities of the bins. The
+   resulting values oscillate around sharp features of the distribution and may be negative,
+   but these oscillations cancel out when integrated against the smooth functions in
+   llrTable.h. */
+void gaussModelCFInvert(llrGrid *grid)
+{
+    unsigned        n0 = grid->n[0];
+    unsigned        n1 = grid->n[1];
+    double          dt0 = 2*M_PI/(n0*grid->h[0]);
+    double          dt1 = 2*M_PI/(n1*grid->h[1]);
+    unsigned        k0, k1, sn;
+    size_t          ind;
+    double complex  val;
+    double complex  shift;
+
+    for(k0=0; k0<n0; k0++)
+        for(k1=0; k1<n1; k1++)
+        {
+            ind   = (size_t)k0*n1+k1;
+            shift = cexp(-I*(gaussFreq(k0,n0,dt0)*grid->lo[0]+gaussFreq(k1,n1,dt1)*grid->lo[1]))/((double)n0*n1);
+            for(sn=0; sn<2; sn++)
+            {
+                val = (grid->val[sn][2*ind] + I*grid->val[sn][2*ind+1])*shift;
+                grid->val[sn][2*ind]   = creal(val);
+                grid->val[sn][2*ind+1] = cimag(val);
+            }
+        }
+    llrGridFFT(grid, 1);
+}
+
+/* Probabilities of the pair (lam,ell) of the population on a bins x bins grid for each
+   stimulus, obtained by inverting their characteristic functions with an FFT */
+llrGrid *gaussModelGrid(const gaussModel *pop, unsigned bins)
+{
+    llrGrid     *grid = llrGridAlloc(bins,bins);
+    unsigned    s, f;
+    double      mean[2][2], var[2][2];
+
+    for(s=0; s<2; s++)
+        for(f=0; f<2; f++)
+            gaussModelMoments(pop, s, f, &mean[s][f], &var[s][f]);
+
+    gaussModelWindow(grid, mean, var);
+    gaussModelCFOne(grid);
+    gaussModelCFGrid(pop, grid, 1);
+    gaussModelCFInvert(grid);
+    return grid;
+}
+
+#endif
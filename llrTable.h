@@ -0,0 +1,523 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Tables and grids of log-likelihood ratios for binary stimuli.
+
+ With two stimuli, the true posterior and the posterior of the NI decoder depend on the
+ response only through the log-likelihood ratios
+
+   lam = log p(r|s1)/p(r|s2)        and        ell = log pNI(r|s1)/pNI(r|s2),
+
+ where pNI(r|s) denotes the product of the marginal likelihoods. The NI decoder with
+ parameter theta is obtained by replacing ell for theta*ell. Hence, the transmitted
+ information and the information losses can be computed from the joint distribution of
+ (lam,ell) given each stimulus. This file contains the functions that read them off.
+
+ The distributions can be stored as a list of weighted points (llrTable), or on a regular
+ grid (llrGrid). Grids can be combined through FFT convolution, because the log-likelihood
+ ratios of conditionally independent streams add.
+
+ This file is included by the mex-files that need it, and requires the following library
+
+ - GSL (https://www.gnu.org/software/gsl/)
+
+ VERSION CONTROL
+
+ V1.000 (18 Oct 2026)
+ V1.001 Grid spacings kept in the tables, and DeltaI_LS in llrMeasures (19 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#ifndef LLRTABLE_H
+#define LLRTABLE_H
+
+#include<stdlib.h>
+#include<math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_min.h>
+#include <gsl/gsl_fft_complex.h>
+
+/* Weighted points (lam,ell). w[s][j] is the probability of the point j given stimulus s.
+   If the points come from a grid, h holds its spacings, and is zero otherwise. */
+typedef struct
+{
+    unsigned    num;
+    double      *w[2];
+    double      *lam;
+    double      *ell;
+    double      h[2];
+} llrTable;
+
+/* Regular grid of n[0] x n[1] bins, stored row-major as GSL packed complex arrays.
+   Bin (i,j) represents lam = lo[0]+i*h[0] and ell = lo[1]+j*h[1]. */
+typedef struct
+{
+    unsigned    n[2];
+    double      lo[2];
+    double      h[2];
+    double      *val[2];
+} llrGrid;
+
+llrTable *llrTableAlloc(unsigned num)
+{
+    llrTable *tab = (llrTable*) malloc(sizeof(llrTable));
+
+    tab->num  = num;
+    tab->w[0] = (double*) calloc(4*(size_t)num+1, sizeof(double));
+    tab->w[1] = tab->w[0] + num;
+    tab->lam  = tab->w[1] + num;
+    tab->ell  = tab->lam  + num;
+    tab->h[0] = tab->h[1] = 0;
+    return tab;
+}
+
+void llrTableFree(llrTable *tab)
+{
+    if(tab==NULL) return;
+    free(tab->w[0]);
+    free(tab);
+}
+
+llrGrid *llrGridAlloc(unsigned n0, unsigned n1)
+{
+    llrGrid *grid = (llrGrid*) malloc(sizeof(llrGrid));
+
+    grid->n[0]   = n0;
+    grid->n[1]   = n1;
+    grid->lo[0]  = grid->lo[1] = 0;
+    grid->h[0]   = grid->h[1]  = 1;
+    grid->val[0] = (double*) calloc(4*(size_t)n0*n1, sizeof(double));
+    grid->val[1] = grid->val[0] + 2*(size_t)n0*n1;
+    return grid;
+}
+
+void llrGridFree(llrGrid *grid)
+{
+    if(grid==NULL) return;
+    free(grid->val[0]);
+    free(grid);
+}
+
+/* log(1+exp(z)) without overflow */
+static inline double softplus(double z)
+{
+    return z>0 ? z+log1p(exp(-z)) : log1p(exp(z));
+}
+
+/* Transmitted information when the stimulus s1 has probability q */
+double llrInfo(const llrTable *tab, double q)
+{
+    unsigned    indj;
+    double      lpr = log(q/(1-q));
+    double      info1 = 0;
+    double      info2 = 0;
+
+    for(indj=0; indj<tab->num; indj++)
+    {
+        info1 -= tab->w[0][indj]*softplus(-tab->lam[indj]-lpr);
+        info2 -= tab->w[1][indj]*softplus( tab->lam[indj]+lpr);
+    }
+    return q*(info1-log(q)) + (1-q)*(info2-log(1-q));
+}
+
+/* Information loss caused by the NI decoder with parameter th. With th=1, it is the
+   descriptive information loss. */
+double llrDI(const llrTable *tab, double q, double th)
+{
+    unsigned    indj;
+    double      lpr = log(q/(1-q));
+    double      di1 = 0;
+    double      di2 = 0;
+    double      lnow;
+    double      enow;
+
+    for(indj=0; indj<tab->num; indj++)
+    {
+        lnow = tab->lam[indj]+lpr;
+        enow = th*tab->ell[indj]+lpr;
+        di1 += tab->w[0][indj]*(softplus(-enow)-softplus(-lnow));
+        di2 += tab->w[1][indj]*(softplus( enow)-softplus( lnow));
+    }
+    return q*di1 + (1-q)*di2;
+}
+
+/* Fraction of a bin of width h centred at z lying above zero */
+static inline double llrBinAbove(double z, double h)
+{
+    if(z>=h/2) return z>0 ? 1 : 0.5;
+    if(z<=-h/2) return z<0 ? 0 : 0.5;
+    return 0.5+z/h;
+}
+
+/* Information about the stimulus carried by an estimate of it, given their joint
+   probabilities p[s][e] */
+double llrEstimateInfo(double p[2][2])
+{
+    unsigned    s, e;
+    double      ps, pe, info = 0;
+
+    for(s=0; s<2; s++)
+        for(e=0; e<2; e++)
+        {
+            ps = p[s][0]+p[s][1];
+            pe = p[0][e]+p[1][e];
+            if(p[s][e]>0 && ps>0 && pe>0) info += p[s][e]*log(p[s][e]/(ps*pe));
+        }
+    return info;
+}
+
+/* Transmitted information and information losses caused by the NI decoders with each of the
+   nth values in th, computed in a single pass over the table, in which the terms of the
+   true posterior are shared by all measures. If dils is not NULL, it receives the decrease
+   in the information carried by the maximum a posteriori estimate of the stimulus when the
+   NI posterior (theta=1) replaces the true one, read off the same pass. The points of a
+   grid are spread uniformly over their bins, so that the bins crossed by the decision
+   boundary are split between both estimates. */
+void llrMeasures(const llrTable *tab, double q, const double *th, unsigned nth, double *info, double *di, double *dils)
+{
+    unsigned    indj, indt, s;
+    double      lpr = log(q/(1-q));
+    double      info1 = 0;
+    double      info2 = 0;
+    double      lnow, enow, sp1, sp2, wnow, etrue, eni;
+    double      ptrue[2][2] = {{0,0},{0,0}}, pni[2][2] = {{0,0},{0,0}};
+
+    for(indt=0; indt<nth; indt++) di[indt] = 0;
+    for(indj=0; indj<tab->num; indj++)
+    {
+        lnow = tab->lam[indj]+lpr;
+        sp1  = softplus(-lnow);
+        sp2  = softplus( lnow);
+        info1 -= tab->w[0][indj]*sp1;
+        info2 -= tab->w[1][indj]*sp2;
+        for(indt=0; indt<nth; indt++)
+        {
+            enow = th[indt]*tab->ell[indj]+lpr;
+            di[indt] += q*tab->w[0][indj]*(softplus(-enow)-sp1)
+                      + (1-q)*tab->w[1][indj]*(softplus(enow)-sp2);
+        }
+        if(dils!=NULL)
+        {
+            /* Probability that each estimate is s1 */
+            enow  = tab->ell[indj]+lpr;
+            etrue = llrBinAbove(lnow, tab->h[0]);
+            eni   = llrBinAbove(enow, tab->h[1]);
+            for(s=0; s<2; s++)
+            {
+                wnow = (s==0 ? q : 1-q)*tab->w[s][indj];
+                ptrue[s][0] += wnow*etrue;
+                ptrue[s][1] += wnow*(1-etrue);
+                pni[s][0]   += wnow*eni;
+                pni[s][1]   += wnow*(1-eni);
+            }
+        }
+    }
+    *info = q*(info1-log(q)) + (1-q)*(info2-log(1-q));
+    if(dils!=NULL) *dils = llrEstimateInfo(ptrue)-llrEstimateInfo(pni);
+}
+
+/* Refines with Brent's method the minimum of fun bracketed by thl < thm < thr, with
+   fun(thm) = dim smaller than fun(thl) = dil and fun(thr) = dir, unless the bracketing
+   failed, in which case the smallest value is returned. Stores the minimizer in thmin, if
+   not NULL. */
+double llrBrent(double (*fun)(double, void*), void *par, double thl, double thm, double thr, double dil, double dim, double dir, double *thmin)
+{
+    double  dimin;
+    int     iter = 0;
+    int     max_iter = 1000;
+
+    /* Flat or monotonic within the allowed number of expansions */
+    if(!(dim<dil && dim<dir))
+    {
+        if(thmin!=NULL) *thmin = dil<dir ? (dil<dim ? thl : thm) : (dir<dim ? thr : thm);
+        return fmin(dim, fmin(dil, dir));
+    }
+
+    /* Minimizing the communication information loss*/
+    gsl_function dith;
+    dith.function = fun;
+    dith.params = par;
+    gsl_min_fminimizer *s = gsl_min_fminimizer_alloc (gsl_min_fminimizer_brent);
+
+    gsl_min_fminimizer_set_with_values (s, &dith, thm, dim, thl, dil, thr, dir);
+
+    do
+    {
+        gsl_min_fminimizer_iterate (s);
+        thl = gsl_min_fminimizer_x_lower(s);
+        thr = gsl_min_fminimizer_x_upper(s);
+    }
+    while (gsl_min_test_interval(thl, thr, 1E-6, 1E-3) == GSL_CONTINUE && ++iter < max_iter);
+
+    dimin = gsl_min_fminimizer_f_minimum (s);
+    if(thmin!=NULL) *thmin = gsl_min_fminimizer_x_minimum (s);
+
+    gsl_min_fminimizer_free (s);
+    return dimin;
+}
+
+/* Minimizes fun over theta, as done in dinidlGaussTheta. Returns the minimum and stores
+   the minimizer in thmin, if not NULL. */
+double llrMinimize(double (*fun)(double, void*), void *par, double *thmin)
+{
+    double  thl = -0.5;
+    double  thm = 0.5;
+    double  thr = 1.5;
+    double  dil = fun(thl,par);
+    double  dim = fun(thm,par);
+    double  dir = fun(thr,par);
+    int     iter = 0;
+    int     max_iter = 1000;
+
+    /* Looking for lower limit of minimization interval*/
+    while(dil<dim && iter++<max_iter)
+    {
+        dir=dim; dim=dil;
+        thr=thm; thm=thl;
+        dil = fun(thl*=2,par);
+    }
+
+    /* Looking for upper limit of minimization interval*/
+    while(dir<dim && iter++<max_iter)
+    {
+        dil=dim; dim=dir;
+        thl=thm; thm=thr;
+        dir=fun(thr*=2,par);
+    }
+
+    return llrBrent(fun, par, thl, thm, thr, dil, dim, dir, thmin);
+}
+
+/* Minimizes fun over theta starting from the interval [th0-step,th0+step], e.g., around the
+   minimizer of a previous, similar problem. The interval moves and doubles its width until
+   it brackets a minimum. */
+double llrMinimizeNear(double (*fun)(double, void*), void *par, double th0, double step, double *thmin)
+{
+    double  thl = th0-step;
+    double  thm = th0;
+    double  thr = th0+step;
+    double  dil = fun(thl,par);
+    double  dim = fun(thm,par);
+    double  dir = fun(thr,par);
+    int     iter = 0;
+    int     max_iter = 1000;
+
+    /* Looking for lower limit of minimization interval*/
+    while(dil<dim && iter++<max_iter)
+    {
+        dir=dim; dim=dil;
+        thr=thm; thm=thl;
+        step *= 2;
+        dil = fun(thl-=step,par);
+    }
+
+    /* Looking for upper limit of minimization interval*/
+    while(dir<dim && iter++<max_iter)
+    {
+        dil=dim; dim=dir;
+        thl=thm; thm=thr;
+        step *= 2;
+        dir=fun(thr+=step,par);
+    }
+
+    return llrBrent(fun, par, thl, thm, thr, dil, dim, dir, thmin);
+}
+
+/* Parameters and objective for minimizing llrDI over theta */
+typedef struct
+{
+    const llrTable  *tab;
+    double          q;
+} llrDIPar;
+
+double llrDITheta(double th, void *par)
+{
+    llrDIPar *dipar = (llrDIPar*) par;
+    return llrDI(dipar->tab, dipar->q, th);
+}
+
+/* Parameters and objective for minimizing over theta the loss of a joint NI decoder of
+   several independent binary features, each with its own table and prior */
+typedef struct
+{
+    unsigned        num;
+    llrTable        **tab;
+    const double    *q;
+} llrSumDIPar;
+
+double llrSumDITheta(double th, void *par)
+{
+    llrSumDIPar *dipar = (llrSumDIPar*) par;
+    unsigned    ind;
+    double      di = 0;
+
+    for(ind=0; ind<dipar->num; ind++)
+        di += llrDI(dipar->tab[ind], dipar->q[ind], th);
+    return di;
+}
+
+/* Adds mass to the grid of stimulus s at the point (u0,u1), measured in bins from the
+   origin of the stream, splitting it linearly among the four closest bins. Indices wrap
+   around the grid, so that the circular convolution of the streams is exact modulo the
+   grid size. */
+void llrGridDeposit(llrGrid *grid, unsigned s, double u0, double u1, double mass)
+{
+    double      fl0, fl1, f0, f1, r0, r1;
+    size_t      i0, i1, j0, j1;
+    double      *v = grid->val[s];
+
+    if(!isfinite(u0) || !isfinite(u1)) return;
+
+    /* fmod is exact, so the bins lie in the grid even for large u0 and u1 */
+    fl0 = floor(u0);
+    fl1 = floor(u1);
+    f0  = u0-fl0;
+    f1  = u1-fl1;
+    r0  = fmod(fl0, grid->n[0]);
+    r1  = fmod(fl1, grid->n[1]);
+    i0  = (size_t)(r0<0 ? r0+grid->n[0] : r0);
+    i1  = (size_t)(r1<0 ? r1+grid->n[1] : r1);
+    j0  = (i0+1)%grid->n[0];
+    j1  = (i1+1)%grid->n[1];
+
+    v[2*(i0*grid->n[1]+i1)] += mass*(1-f0)*(1-f1);
+    v[2*(i0*grid->n[1]+j1)] += mass*(1-f0)*f1;
+    v[2*(j0*grid->n[1]+i1)] += mass*f0*(1-f1);
+    v[2*(j0*grid->n[1]+j1)] += mass*f0*f1;
+}
+
+/* Two-dimensional FFT of the grids of both stimuli. Direction is +1 for the forward
+   transform and -1 for the inverse transform. */
+void llrGridFFT(llrGrid *grid, int direction)
+{
+    unsigned    s;
+    size_t      ind;
+    double      *v;
+
+    for(s=0; s<2; s++)
+    {
+        v = grid->val[s];
+        for(ind=0; ind<grid->n[0]; ind++)
+            if(direction>0)
+                gsl_fft_complex_radix2_forward(v+2*ind*grid->n[1], 1, grid->n[1]);
+            else
+                gsl_fft_complex_radix2_inverse(v+2*ind*grid->n[1], 1, grid->n[1]);
+        for(ind=0; ind<grid->n[1]; ind++)
+            if(direction>0)
+                gsl_fft_complex_radix2_forward(v+2*ind, grid->n[1], grid->n[0]);
+            else
+                gsl_fft_complex_radix2_inverse(v+2*ind, grid->n[1], grid->n[0]);
+    }
+}
+
+/* Multiplies the transformed grid acc by the transformed grid g raised to the power pw,
+   which accounts for pw identical independent streams */
+void llrGridMulPow(llrGrid *acc, const llrGrid *g, unsigned pw)
+{
+    unsigned    s;
+    unsigned    p;
+    size_t      ind;
+    size_t      num = (size_t)acc->n[0]*acc->n[1];
+    double      br, bi, rr, ri, tr;
+
+    for(s=0; s<2; s++)
+        for(ind=0; ind<num; ind++)
+        {
+            br = g->val[s][2*ind];
+            bi = g->val[s][2*ind+1];
+            rr = 1;
+            ri = 0;
+            for(p=pw; p>0; p>>=1)
+            {
+                if(p&1) { tr = rr*br-ri*bi; ri = rr*bi+ri*br; rr = tr; }
+                tr = br*br-bi*bi; bi = 2*br*bi; br = tr;
+            }
+            tr = acc->val[s][2*ind]*rr-acc->val[s][2*ind+1]*ri;
+            acc->val[s][2*ind+1] = acc->val[s][2*ind]*ri+acc->val[s][2*ind+1]*rr;
+            acc->val[s][2*ind]   = tr;
+        }
+}
+
+/* Converts the (untransformed) grid into a table, dropping negligible bins. If clip is
+   nonzero, negative values are taken as rounding errors and set to zero. Otherwise, they
+   are kept, as required by grids obtained from characteristic functions, whose oscillations
+   cancel out when integrated against smooth functions. */
+llrTable *llrGridToTable(const llrGrid *grid, int clip)
+{
+    size_t      ind;
+    size_t      num = (size_t)grid->n[0]*grid->n[1];
+    unsigned    indj = 0;
+    double      w1, w2;
+    double      wmax = 0;
+    llrTable    *tab;
+
+    for(ind=0; ind<num; ind++)
+    {
+        if(fabs(grid->val[0][2*ind])>wmax) wmax = fabs(grid->val[0][2*ind]);
+        if(fabs(grid->val[1][2*ind])>wmax) wmax = fabs(grid->val[1][2*ind]);
+    }
+    wmax *= 1E-15;
+
+    for(ind=0; ind<num; ind++)
+        if(fabs(grid->val[0][2*ind])>wmax || fabs(grid->val[1][2*ind])>wmax) indj++;
+
+    tab = llrTableAlloc(indj);
+    tab->h[0] = grid->h[0];
+    tab->h[1] = grid->h[1];
+    indj = 0;
+    for(ind=0; ind<num; ind++)
+    {
+        w1 = grid->val[0][2*ind];
+        w2 = grid->val[1][2*ind];
+        if(fabs(w1)>wmax || fabs(w2)>wmax)
+        {
+            tab->w[0][indj] = (clip && w1<0) ? 0 : w1;
+            tab->w[1][indj] = (clip && w2<0) ? 0 : w2;
+            tab->lam[indj]  = grid->lo[0] + (ind/grid->n[1])*grid->h[0];
+            tab->ell[indj]  = grid->lo[1] + (ind%grid->n[1])*grid->h[1];
+            indj++;
+        }
+    }
+    return tab;
+}
+
+#endif
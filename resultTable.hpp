@@ -0,0 +1,366 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Table of finished results shared by all processes of a machine (e.g., several Matlab
+ sessions running Fig4codeC and Python processes running Fig7code), so that points
+ computed by one process are not computed again by the others.
+
+ The table is an open-addressing hash table in POSIX shared memory (shm_open and mmap),
+ created by the first process that opens it and found by the others by its name. Entries
+ are inserted and updated with atomic compare-and-swap operations, without locks, so that
+ a process stopped or killed at any time cannot block the others. Each entry holds a
+ domain, identifying the computation and its settings (e.g., the integrand and the
+ tolerances), the parameters of the point, canonicalized by rounding them to 40 bits of
+ mantissa and replacing -0 by 0, and up to RT_NVAL results.
+
+ A process about to compute a point calls acquire(), which returns the results if the
+ point is finished (RT_HIT), claims the point for the process (RT_OWNED), or reports that
+ another process is computing it (RT_BUSY). The owner calls publish() with the results
+ or, if it gives up, release(). Busy points can be polled with poll(), and claims of
+ processes that no longer exist, or released claims, are taken over by the next process
+ that finds them. If the table is full, acquire() returns RT_FULL and the point should
+ be computed without the table.
+
+ Tables persist until removed with unlink() (or until the machine restarts), and can be
+ listed in /dev/shm in Linux. This file requires no external library, but linking may
+ require -lrt in old versions of glibc.
+
+ VERSION CONTROL
+
+ V1.000 (19 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#ifndef RESULTTABLE_HPP
+#define RESULTTABLE_HPP
+
+#include<cmath>
+#include<cstddef>
+#include<cstdint>
+#include<cstring>
+#include<cerrno>
+#include<ctime>
+#include<fcntl.h>
+#include<unistd.h>
+#include<signal.h>
+#include<sched.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+
+/* Maximum number of parameters and results of each entry */
+#define RT_NKEY 8
+#define RT_NVAL 8
+
+/* Outcomes of acquire() and poll() */
+#define RT_HIT      0
+#define RT_OWNED    1
+#define RT_BUSY     2
+#define RT_FULL     3
+
+/* States of an entry, stored in the two lowest bits of its owner word together with the
+   process identifier of its owner */
+#define RT_CLAIMED  1
+#define RT_DONE     2
+#define RT_RELEASED 3
+
+#define RT_MAGIC    0x6469646c52546231ULL
+
+/* Attempts to read the key of an entry being inserted before skipping it */
+#define RT_WAITKEY  100000
+
+class ResultTable
+{
+public:
+    ResultTable() : head(NULL), slots(NULL), bytes(0) {}
+    ~ResultTable() { close(); }
+
+    /* Opens the table name (e.g., "/dinidl"), creating it with room for capacity entries
+       (rounded up to a power of two) if it does not exist. Returns 0 on failure, including
+       when an existing table has a different layout. */
+    int open(const char *name, size_t capacity)
+    {
+        size_t      cap = 1;
+        struct stat st;
+        int         fid, created = 1;
+
+        close();
+        while(cap<capacity) cap <<= 1;
+        fid = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+        if(fid<0 && errno==EEXIST)
+        {
+            created = 0;
+            fid = shm_open(name, O_RDWR, 0600);
+        }
+        if(fid<0) return 0;
+
+        if(created)
+        {
+            bytes = sizeof(Header) + cap*sizeof(Entry);
+            if(ftruncate(fid, (off_t)bytes)!=0) { ::close(fid); shm_unlink(name); return 0; }
+        }
+        else
+        {
+            /* Waits for the creator to set the size */
+            for(;;)
+            {
+                if(fstat(fid, &st)!=0) { ::close(fid); return 0; }
+                if(st.st_size>0) break;
+                sleepNs(1000000);
+            }
+            bytes = (size_t)st.st_size;
+        }
+
+        head = (Header*) mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fid, 0);
+        ::close(fid);
+        if(head==MAP_FAILED) { head = NULL; return 0; }
+        slots = (Entry*)(head+1);
+
+        if(created)
+        {
+            head->capacity = cap;
+            head->nkey     = RT_NKEY;
+            head->nval     = RT_NVAL;
+            __atomic_store_n(&head->magic, RT_MAGIC, __ATOMIC_RELEASE);
+        }
+        else
+        {
+            while(__atomic_load_n(&head->magic, __ATOMIC_ACQUIRE)!=RT_MAGIC) sleepNs(1000000);
+            if(head->nkey!=RT_NKEY || head->nval!=RT_NVAL ||
+               bytes!=sizeof(Header)+head->capacity*sizeof(Entry))
+            {
+                close();
+                return 0;
+            }
+        }
+        return 1;
+    }
+
+    void close()
+    {
+        if(head!=NULL) munmap(head, bytes);
+        head  = NULL;
+        slots = NULL;
+    }
+
+    /* Removes the table name from the system, once all processes close it */
+    static int unlink(const char *name) { return shm_unlink(name)==0; }
+
+    int isOpen() const { return head!=NULL; }
+
+    /* Domain of a computation, from a string describing it and its settings */
+    static uint64_t domain(const char *desc)
+    {
+        uint64_t    h = 14695981039346656037ULL;
+
+        while(*desc) h = (h ^ (unsigned char)*desc++)*1099511628211ULL;
+        return h;
+    }
+
+    /* Looks for the point key (of nkey values) of the domain dom. Returns RT_HIT and copies
+       its results to val if it is finished, RT_OWNED if the point is now claimed by this
+       process, RT_BUSY if another live process has claimed it, or RT_FULL if the point is
+       not in the table and there is no room for it. Except in the last case, slot receives
+       the entry of the point, for publish(), release() and poll(). */
+    int acquire(uint64_t dom, const double *key, unsigned nkey, double *val, size_t *slot)
+    {
+        double      ckey[RT_NKEY];
+        uint64_t    h, tag, zero;
+        size_t      mask, ind, probe;
+        unsigned    spin;
+        Entry       *e;
+
+        if(head==NULL || nkey>RT_NKEY) return RT_FULL;
+        canonical(key, nkey, ckey);
+        h    = hash(dom, ckey) | 1;
+        mask = head->capacity-1;
+
+        for(probe=0; probe<=mask; probe++)
+        {
+            ind = (h+probe) & mask;
+            e   = slots+ind;
+            tag = __atomic_load_n(&e->tag, __ATOMIC_ACQUIRE);
+            if(tag==0)
+            {
+                zero = 0;
+                if(__atomic_compare_exchange_n(&e->tag, &zero, h, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+                {
+                    e->dom = dom;
+                    memcpy(e->key, ckey, sizeof(ckey));
+                    __atomic_store_n(&e->owner, self() | RT_CLAIMED, __ATOMIC_RELEASE);
+                    *slot = ind;
+                    return RT_OWNED;
+                }
+                tag = zero;
+            }
+            if(tag!=h) continue;
+
+            /* The key is written before the owner word, which is never reset. Entries
+               whose key is never written, because the process inserting them died, are
+               skipped after a while. */
+            for(spin=0; spin<RT_WAITKEY && __atomic_load_n(&e->owner, __ATOMIC_ACQUIRE)==0; spin++) sched_yield();
+            if(spin==RT_WAITKEY) continue;
+            if(e->dom!=dom || memcmp(e->key, ckey, sizeof(ckey))!=0) continue;
+            *slot = ind;
+            return poll(ind, val);
+        }
+        return RT_FULL;
+    }
+
+    /* Checks the state of a point found by acquire(), as in acquire(). A claim is taken
+       over if it was released or its owner no longer exists. */
+    int poll(size_t slot, double *val)
+    {
+        Entry       *e = slots+slot;
+        uint64_t    word, pid;
+
+        for(;;)
+        {
+            word = __atomic_load_n(&e->owner, __ATOMIC_ACQUIRE);
+            if((word & 3)==RT_DONE)
+            {
+                if(val!=NULL) memcpy(val, e->val, sizeof(e->val));
+                return RT_HIT;
+            }
+            pid = word >> 2;
+            if((word & 3)==RT_CLAIMED && (pid==(uint64_t)getpid() || kill((pid_t)pid, 0)==0 || errno!=ESRCH))
+                return RT_BUSY;
+            if(__atomic_compare_exchange_n(&e->owner, &word, self() | RT_CLAIMED, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+                return RT_OWNED;
+        }
+    }
+
+    /* Stores the results (of nval values) of a point claimed by this process */
+    void publish(size_t slot, const double *val, unsigned nval)
+    {
+        Entry       *e = slots+slot;
+        unsigned    k;
+
+        for(k=0; k<RT_NVAL; k++) e->val[k] = k<nval ? val[k] : 0;
+        __atomic_store_n(&e->owner, self() | RT_DONE, __ATOMIC_RELEASE);
+    }
+
+    /* Gives up a point claimed by this process, so that others can compute it */
+    void release(size_t slot)
+    {
+        __atomic_store_n(&slots[slot].owner, self() | RT_RELEASED, __ATOMIC_RELEASE);
+    }
+
+    /* Number of entries and entries in use */
+    size_t capacity() const { return head!=NULL ? head->capacity : 0; }
+
+    size_t used() const
+    {
+        size_t  ind, num = 0;
+
+        for(ind=0; ind<capacity(); ind++)
+            if(__atomic_load_n(&slots[ind].tag, __ATOMIC_RELAXED)!=0) num++;
+        return num;
+    }
+
+    /* Sleeps for ns nanoseconds, e.g., between calls to poll() */
+    static void sleepNs(long ns)
+    {
+        struct timespec ts;
+
+        ts.tv_sec  = ns/1000000000L;
+        ts.tv_nsec = ns%1000000000L;
+        nanosleep(&ts, NULL);
+    }
+
+private:
+    struct Header
+    {
+        uint64_t    magic;
+        uint64_t    capacity;
+        uint64_t    nkey;
+        uint64_t    nval;
+    };
+
+    /* tag: hash of the domain and key, or 0 if empty. owner: (pid << 2) | state, or 0
+       while the key is being written. */
+    struct Entry
+    {
+        uint64_t    tag;
+        uint64_t    owner;
+        uint64_t    dom;
+        double      key[RT_NKEY];
+        double      val[RT_NVAL];
+    };
+
+    Header      *head;
+    Entry       *slots;
+    size_t      bytes;
+
+    static uint64_t self() { return (uint64_t)getpid() << 2; }
+
+    static void canonical(const double *key, unsigned nkey, double *ckey)
+    {
+        double      man;
+        unsigned    k;
+        int         ex;
+
+        for(k=0; k<RT_NKEY; k++)
+        {
+            if(k>=nkey) { ckey[k] = 0; continue; }
+            man     = frexp(key[k], &ex);
+            ckey[k] = ldexp(std::round(ldexp(man, 40)), ex-40) + 0.0;
+        }
+    }
+
+    static uint64_t hash(uint64_t dom, const double *ckey)
+    {
+        uint64_t    h = dom, bits;
+        unsigned    k;
+
+        for(k=0; k<RT_NKEY; k++)
+        {
+            memcpy(&bits, ckey+k, sizeof(bits));
+            h ^= bits + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        }
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return h;
+    }
+};
+
+#endif
@@ -0,0 +1,245 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ C interface of the sweep runner of sweepRunner.hpp, compiled as a shared library for
+ sweepRunner.py (Python). A sweep is created with sweepCreate, run with sweepRun (which
+ blocks, and can be called from a separate thread), monitored with sweepProgress and
+ cancelled with sweepCancel from other threads, and its results are copied with
+ sweepResults before releasing it with sweepFree. Before running, sweepUseHistory orders
+ the points by the costs predicted from the records of previous runs, and after running,
+ sweepSaveHistory adds the finished points to the records. sweepPartitionPoints splits a
+ sweep into chunks of similar predicted cost. sweepUseMeshes stores the partitions of the
+ cubatures for later runs, and sweepWarmStart starts them from those of the nearest point
+ finished.
+
+ The functions starting with table give access to the shared result tables of
+ resultTable.hpp, both for sharing the results of sweeps (sweepUseTable) and for any other
+ computation of the Python code (e.g., Fig7code.py).
+
+ The code requires no external library, and can be compiled as follows
+
+   g++ -std=c++11 -O2 -fopenmp -shared -fPIC -o libsweepRunner.so sweepRunner.cpp -lrt
+
+ The OpenMP flags are optional.
+
+ VERSION CONTROL
+
+ V1.000 (19 Oct 2026)
+ V1.001 Shared result tables (19 Oct 2026)
+ V1.002 Stored partitions of the cubatures (19 Oct 2026)
+ V1.003 Cubatures started from neighbouring points (19 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#include "sweepRunner.hpp"
+
+extern "C"
+{
+
+void *sweepCreate(const double *par, size_t npt)
+{
+    return new SweepRunner(par, npt);
+}
+
+void sweepSetCost(void *sweep, const double *cost)
+{
+    ((SweepRunner*)sweep)->setCost(cost);
+}
+
+void sweepRun(void *sweep, int nthreads)
+{
+    ((SweepRunner*)sweep)->run(nthreads);
+}
+
+void sweepCancel(void *sweep)
+{
+    ((SweepRunner*)sweep)->cancel();
+}
+
+void sweepProgress(void *sweep, SweepProgress *prog)
+{
+    *prog = ((SweepRunner*)sweep)->progress();
+}
+
+/* Copies the results to arrays of one element per point. Points that did not finish have
+   NaN losses and done = 0. */
+void sweepResults(void *sweep, double *di, double *theta, double *err, double *evals, double *seconds, unsigned char *done)
+{
+    SweepRunner *run = (SweepRunner*)sweep;
+    size_t      ind;
+
+    for(ind=0; ind<run->finished().size(); ind++)
+    {
+        if(di)      di[ind]      = run->losses()[ind];
+        if(theta)   theta[ind]   = run->thetas()[ind];
+        if(err)     err[ind]     = run->errors()[ind];
+        if(evals)   evals[ind]   = (double)run->evaluations()[ind];
+        if(seconds) seconds[ind] = run->times()[ind];
+        if(done)    done[ind]    = run->finished()[ind];
+    }
+}
+
+/* Predicts the costs of the points with the model fitted to the records of the file, and
+   returns the number of records (zero if the file cannot be read) */
+int sweepUseHistory(void *sweep, const char *file)
+{
+    SweepCostModel  model;
+
+    model.load(file);
+    ((SweepRunner*)sweep)->setCost(model);
+    return (int)model.records();
+}
+
+/* Appends the evaluations of the finished points to the records of the file. Returns 0 on
+   failure. */
+int sweepSaveHistory(void *sweep, const char *file)
+{
+    SweepCostModel  model;
+
+    ((SweepRunner*)sweep)->record(model);
+    return model.save(file);
+}
+
+/* Splits the points par into nchunk chunks of similar predicted cost, with the model
+   fitted to the records of the file (or the default model, if file is NULL) */
+double sweepPartitionPoints(const double *par, size_t npt, const char *file, unsigned nchunk, unsigned *chunk)
+{
+    SweepCostModel      model;
+    std::vector<double> cost(npt);
+    size_t              ind;
+
+    if(file!=NULL) model.load(file);
+    for(ind=0; ind<npt; ind++) cost[ind] = model.predict(par+3*ind);
+    return sweepPartition(cost.data(), npt, nchunk, chunk);
+}
+
+/* Number of points taken from the table, and which ones (if shared is not NULL) */
+size_t sweepShared(void *sweep, unsigned char *shared)
+{
+    SweepRunner *run = (SweepRunner*)sweep;
+    size_t      ind, num = 0;
+
+    for(ind=0; ind<run->fromTable().size(); ind++)
+    {
+        if(shared) shared[ind] = run->fromTable()[ind];
+        num += run->fromTable()[ind];
+    }
+    return num;
+}
+
+/* Shares the results of the sweep through a table opened with tableOpen */
+void sweepUseTable(void *sweep, void *table)
+{
+    ((SweepRunner*)sweep)->setTable((ResultTable*)table);
+}
+
+/* Starts the cubatures from the partitions stored in the folder dir, and stores the final
+   ones there */
+void sweepUseMeshes(void *sweep, const char *dir)
+{
+    ((SweepRunner*)sweep)->setMeshDir(dir);
+}
+
+/* Starts the cubatures of each point from the partitions of the nearest point finished */
+void sweepWarmStart(void *sweep, int on)
+{
+    ((SweepRunner*)sweep)->setWarmStart(on);
+}
+
+void sweepFree(void *sweep)
+{
+    delete (SweepRunner*)sweep;
+}
+
+/* Opens (or creates) the table name, returning NULL on failure */
+void *tableOpen(const char *name, size_t capacity)
+{
+    ResultTable *table = new ResultTable;
+
+    if(table->open(name, capacity)) return table;
+    delete table;
+    return NULL;
+}
+
+void tableClose(void *table)
+{
+    delete (ResultTable*)table;
+}
+
+int tableUnlink(const char *name)
+{
+    return ResultTable::unlink(name);
+}
+
+uint64_t tableDomain(const char *desc)
+{
+    return ResultTable::domain(desc);
+}
+
+int tableAcquire(void *table, uint64_t dom, const double *key, unsigned nkey, double *val, size_t *slot)
+{
+    return ((ResultTable*)table)->acquire(dom, key, nkey, val, slot);
+}
+
+int tablePoll(void *table, size_t slot, double *val)
+{
+    return ((ResultTable*)table)->poll(slot, val);
+}
+
+void tablePublish(void *table, size_t slot, const double *val, unsigned nval)
+{
+    ((ResultTable*)table)->publish(slot, val, nval);
+}
+
+void tableRelease(void *table, size_t slot)
+{
+    ((ResultTable*)table)->release(slot);
+}
+
+/* Number of entries in use, and capacity (if not NULL) */
+size_t tableUsed(void *table, size_t *capacity)
+{
+    if(capacity) *capacity = ((ResultTable*)table)->capacity();
+    return ((ResultTable*)table)->used();
+}
+
+}
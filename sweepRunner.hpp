@@ -0,0 +1,645 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Runner for sweeps over the points [q,rho1,rho2] of Figure 4, each solved as in
+ dinidlGaussThetaT, that can be monitored and cancelled while it runs.
+
+ The points are distributed among the available cores. At any time, progress() reports
+ the number of points completed and in total, the elapsed time, the estimated time to
+ finish, and the sum and maximum of the error estimates of the cubatures of the finished
+ points. The estimated time to finish assumes that the time of each point is proportional
+ to its predicted cost, calibrated on the points already finished.
+
+ The cost of each point, which grows with |rho1|, |rho2| and the imbalance of q, is
+ predicted by SweepCostModel from the number of evaluations of the integrands recorded in
+ previous runs. Points start in decreasing order of predicted cost, so that the time of the
+ sweep approaches the total work divided by the number of cores instead of being dominated
+ by expensive points started last. The same predictions split sweeps into chunks of
+ similar cost for distributed runs (sweepPartition). The cancel token, set by cancel(), is
+ checked by the workers before starting each point, so a cancelled sweep stops once the
+ points in progress finish, and keeps all the points finished so far. The number of
+ evaluations of the integrands and the time taken by each point are recorded.
+
+ Sweeps run at the same time by different processes of the machine (e.g., Matlab sessions
+ and Python processes) can share their results through a ResultTable (resultTable.hpp),
+ set by setTable(). Each point is then computed by only one of them.
+
+ With setMeshDir(), the cubatures of each point start from the partitions of the domain
+ stored in a folder by previous runs for points in the same cell of the parameter space
+ (cells of width SWEEP_MESHCELL along q, rho1 and rho2), and the final partitions are
+ stored in turn. Since the cubatures usually stop at their maximum number of evaluations,
+ the gain is mostly in accuracy: the evaluations are spent on the regions that matter
+ from the start.
+
+ With setWarmStart(), points without stored partitions start from the final partitions of
+ the nearest point already finished in the sweep, if any lies within SWEEP_WARMRADIUS
+ along each of q, rho1 and rho2. The cubatures evaluate those regions again for the new
+ parameters, merge the regions with negligible errors and refine the rest, skipping the
+ early refinement levels that would otherwise be repeated for every point.
+
+ This file is included by dinidlSweep.cpp (Matlab) and sweepRunner.cpp (C interface of
+ the shared library used by sweepRunner.py), and requires no external library.
+
+ VERSION CONTROL
+
+ V1.000 (19 Oct 2026)
+ V1.001 Results shared among processes through a ResultTable (19 Oct 2026)
+ V1.002 Partitions of the cubatures stored for later runs (19 Oct 2026)
+ V1.003 Cubatures started from the partitions of neighbouring points (19 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#ifndef SWEEPRUNNER_HPP
+#define SWEEPRUNNER_HPP
+
+#include<cmath>
+#include<cstddef>
+#include<vector>
+#include<atomic>
+#include<mutex>
+#include<chrono>
+#include<deque>
+#include<string>
+#include<utility>
+#include<algorithm>
+#include<cstdio>
+#ifdef _OPENMP
+#include<omp.h>
+#endif
+#include "templateCubature.hpp"
+#include "figIntegrands.hpp"
+#include "resultTable.hpp"
+
+/* Domain of the results of the sweeps in a ResultTable, which must change whenever the
+   integrands, domains or tolerances of FigLoss change. The settings of the stored and
+   warm-started partitions, which change the results, are appended (see tableDomain). */
+#define SWEEP_DOMAIN "Fig4 FigLoss [-5,5] maxEval 1000 reqAbsError 1e-6 reqRelError 1e-3"
+
+/* Width of the cells of parameters sharing the stored partitions of the cubatures */
+#define SWEEP_MESHCELL 0.05
+
+/* Largest distance along each parameter to the point whose partitions start the cubatures
+   of another */
+#define SWEEP_WARMRADIUS 0.25
+
+/* State of a sweep, as reported while it runs. The layout is that of a C struct, so that
+   it can be read through the C interface of sweepRunner.cpp. */
+extern "C"
+{
+typedef struct
+{
+    double      completed;      /* number of points finished */
+    double      total;          /* number of points in the sweep */
+    double      elapsed;        /* seconds since the sweep started */
+    double      eta;            /* estimated seconds until the sweep finishes */
+    double      errsum;         /* sum of the error estimates of the finished points */
+    double      errmax;         /* largest error estimate of the finished points */
+    int         running;
+    int         cancelled;
+} SweepProgress;
+}
+
+/* Number of features of the cost model */
+#define SWEEP_NFEAT 5
+
+/* Model of the cost of each point, measured in evaluations of the integrands, as
+   log(evals) = w'*f, where f are the features of the point computed by features(). The
+   weights start from values fitted to the evaluations of dinidlGaussThetaT over the whole
+   parameter space, and are refitted by least squares to the evaluations recorded in
+   previous runs, with a ridge penalty that pulls them towards the starting values when the
+   records are few. Records are stored as lines "q rho1 rho2 evals" of a text file. */
+class SweepCostModel
+{
+public:
+    SweepCostModel() : nold(0)
+    {
+        const double    w0[SWEEP_NFEAT] = {9.958, 0.04543, 0.04243, -0.06415, -0.1053};
+
+        prior.assign(w0, w0+SWEEP_NFEAT);
+        w = prior;
+    }
+
+    static void features(const double *par, double *f)
+    {
+        f[0] = 1;
+        f[1] = -log1p(-par[1]*par[1]);
+        f[2] = -log1p(-par[2]*par[2]);
+        f[3] = fabs(log(par[0]/(1-par[0])));
+        f[4] = par[1]*par[2];
+    }
+
+    /* Predicted number of evaluations of the point par */
+    double predict(const double *par) const
+    {
+        double      f[SWEEP_NFEAT], val = 0;
+        unsigned    k;
+
+        features(par, f);
+        for(k=0; k<SWEEP_NFEAT; k++) val += w[k]*f[k];
+        return exp(val);
+    }
+
+    void add(const double *par, double evals)
+    {
+        if(!(evals>0)) return;
+        rec.push_back(par[0]);
+        rec.push_back(par[1]);
+        rec.push_back(par[2]);
+        rec.push_back(evals);
+    }
+
+    /* Reads the records of a file and refits the model. Returns 0 if the file cannot be
+       read, which leaves the model unchanged. */
+    int load(const char *file)
+    {
+        FILE    *fid = fopen(file, "r");
+        double  val[4];
+
+        if(fid==NULL) return 0;
+        while(fscanf(fid, "%lf %lf %lf %lf", val, val+1, val+2, val+3)==4) add(val, val[3]);
+        fclose(fid);
+        nold = rec.size();
+        fit();
+        return 1;
+    }
+
+    /* Appends the records added since the last load to a file. Returns 0 on failure. */
+    int save(const char *file)
+    {
+        FILE    *fid = fopen(file, "a");
+        size_t  ind;
+
+        if(fid==NULL) return 0;
+        for(ind=nold; ind<rec.size(); ind+=4)
+            fprintf(fid, "%.17g %.17g %.17g %.17g\n",
+                    rec[ind], rec[ind+1], rec[ind+2], rec[ind+3]);
+        fclose(fid);
+        nold = rec.size();
+        return 1;
+    }
+
+    /* Least squares on log(evals) with the ridge penalty lambda*|w-prior|^2 */
+    void fit(double lambda = 1)
+    {
+        double      M[SWEEP_NFEAT*SWEEP_NFEAT], L[SWEEP_NFEAT*SWEEP_NFEAT];
+        double      b[SWEEP_NFEAT], f[SWEEP_NFEAT];
+        double      sum;
+        size_t      ind;
+        unsigned    i, j, k;
+
+        for(i=0; i<SWEEP_NFEAT; i++)
+        {
+            b[i] = lambda*prior[i];
+            for(j=0; j<SWEEP_NFEAT; j++) M[i*SWEEP_NFEAT+j] = i==j ? lambda : 0;
+        }
+        for(ind=0; ind<rec.size(); ind+=4)
+        {
+            features(&rec[ind], f);
+            for(i=0; i<SWEEP_NFEAT; i++)
+            {
+                b[i] += f[i]*log(rec[ind+3]);
+                for(j=0; j<SWEEP_NFEAT; j++) M[i*SWEEP_NFEAT+j] += f[i]*f[j];
+            }
+        }
+
+        /* Cholesky decomposition and substitutions */
+        for(j=0; j<SWEEP_NFEAT; j++)
+            for(i=j; i<SWEEP_NFEAT; i++)
+            {
+                sum = M[i*SWEEP_NFEAT+j];
+                for(k=0; k<j; k++) sum -= L[i*SWEEP_NFEAT+k]*L[j*SWEEP_NFEAT+k];
+                L[i*SWEEP_NFEAT+j] = i==j ? sqrt(sum) : sum/L[j*SWEEP_NFEAT+j];
+            }
+        for(i=0; i<SWEEP_NFEAT; i++)
+        {
+            sum = b[i];
+            for(k=0; k<i; k++) sum -= L[i*SWEEP_NFEAT+k]*b[k];
+            b[i] = sum/L[i*SWEEP_NFEAT+i];
+        }
+        for(i=SWEEP_NFEAT; i-->0;)
+        {
+            sum = b[i];
+            for(k=i+1; k<SWEEP_NFEAT; k++) sum -= L[k*SWEEP_NFEAT+i]*w[k];
+            w[i] = sum/L[i*SWEEP_NFEAT+i];
+        }
+    }
+
+    size_t records() const { return rec.size()/4; }
+
+private:
+    std::vector<double>     prior, w, rec;
+    size_t                  nold;
+};
+
+/* Splits the points with predicted costs cost into nchunk chunks of similar total cost,
+   e.g., for distributing a sweep among machines. Points are assigned in decreasing order
+   of cost to the chunk with the smallest total so far. Stores the chunk of each point,
+   from 0 to nchunk-1, and returns the largest total cost of a chunk. */
+inline double sweepPartition(const double *cost, size_t npt, unsigned nchunk,
+                             unsigned *chunk)
+{
+    std::vector<size_t> order(npt);
+    std::vector<double> load(nchunk, 0);
+    size_t              ind;
+    unsigned            k, best;
+
+    for(ind=0; ind<npt; ind++) order[ind] = ind;
+    std::stable_sort(order.begin(), order.end(),
+                     [cost](size_t a, size_t b) { return cost[a]>cost[b]; });
+    for(ind=0; ind<npt; ind++)
+    {
+        best = 0;
+        for(k=1; k<nchunk; k++) if(load[k]<load[best]) best = k;
+        chunk[order[ind]] = best;
+        load[best] += cost[order[ind]];
+    }
+    return npt>0 ? *std::max_element(load.begin(), load.end()) : 0;
+}
+
+/* Sweep over points [q,rho1,rho2] of Figure 4, each solved as in dinidlGaussThetaT */
+class SweepRunner
+{
+public:
+    /* par holds npt points [q,rho1,rho2], stored row-major */
+    SweepRunner(const double *par, size_t npt) :
+        par(par, par+3*npt), cost(npt, 1), di(npt, NAN), theta(npt, NAN), err(npt, NAN),
+        seconds(npt, 0), evals(npt, 0), done(npt, 0), shared(npt, 0), order(npt),
+        table(NULL), warm(0), ncompleted(0), stop(false), running(false), costdone(0),
+        errsum(0), errmax(0), elapsedEnd(0)
+    {
+        for(size_t ind=0; ind<npt; ind++) order[ind] = ind;
+    }
+
+    /* Predicted relative cost of each point, used to estimate the remaining time and to
+       start the most expensive points first, so that the cheap ones fill the gaps at the
+       end of the sweep. Must be called before run(). */
+    void setCost(const double *val)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        cost.assign(val, val+done.size());
+        std::stable_sort(order.begin(), order.end(),
+                         [this](size_t a, size_t b) { return cost[a]>cost[b]; });
+    }
+
+    /* Costs predicted by the model */
+    void setCost(const SweepCostModel &model)
+    {
+        std::vector<double> val(done.size());
+        size_t              ind;
+
+        for(ind=0; ind<done.size(); ind++) val[ind] = model.predict(&par[3*ind]);
+        setCost(val.data());
+    }
+
+    /* Adds the evaluations of the points finished by this sweep to the records of the
+       model */
+    void record(SweepCostModel &model) const
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        size_t                      ind;
+
+        for(ind=0; ind<done.size(); ind++)
+            if(done[ind] && !shared[ind]) model.add(&par[3*ind], (double)evals[ind]);
+    }
+
+    /* Shares the results with other processes through an open table (or none, if NULL).
+       Points finished by others are taken from the table, points being computed by others
+       are left until the end and then awaited, and the rest are claimed, computed and
+       published. Must be called before run(). */
+    void setTable(ResultTable *tab)
+    {
+        table = tab;
+    }
+
+    /* Description of the results in the table, including the settings of the partitions */
+    std::string tableDomain() const
+    {
+        std::string desc = SWEEP_DOMAIN;
+
+        if(!meshdir.empty()) desc += " meshes " + meshdir;
+        if(warm) desc += " warm " + std::to_string(SWEEP_WARMRADIUS);
+        return desc;
+    }
+
+    /* Solves all points with nthreads threads (0 for the default of OpenMP). Workers check
+       the cancel token before starting each point, so a cancelled sweep returns after
+       the points in progress finish, keeping all the finished points. */
+    void run(int nthreads)
+    {
+        long    ind;
+        long    npt = (long)done.size();
+
+        start   = std::chrono::steady_clock::now();
+        running = true;
+        if(table!=NULL) dom = ResultTable::domain(tableDomain().c_str());
+        if(nthreads<=0) nthreads = sweepMaxThreads();
+
+        #pragma omp parallel for schedule(dynamic,1) num_threads(nthreads)
+        for(ind=0; ind<npt; ind++)
+        {
+            if(stop.load()) continue;
+            if(table!=NULL)
+                acquire(order[ind]);
+            else
+                solve(order[ind]);
+        }
+        if(table!=NULL) awaitPending(nthreads);
+
+        elapsedEnd = elapsed();
+        running = false;
+    }
+
+    /* Cancel token: stops the workers at the next point */
+    void cancel() { stop = true; }
+
+    SweepProgress progress() const
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        SweepProgress   prog;
+        double          costall = 0;
+        size_t          ind;
+
+        for(ind=0; ind<cost.size(); ind++) costall += cost[ind];
+        prog.completed = (double)ncompleted.load();
+        prog.total     = (double)done.size();
+        prog.elapsed   = running ? elapsed() : elapsedEnd;
+        prog.eta       = costdone>0 ? prog.elapsed*(costall-costdone)/costdone : NAN;
+        if(!running || stop) prog.eta = 0;
+        prog.errsum    = errsum;
+        prog.errmax    = errmax;
+        prog.running   = running;
+        prog.cancelled = stop;
+        return prog;
+    }
+
+    /* Stores the partitions of the cubatures in the folder dir (or none, if NULL or empty),
+       which must exist. Must be called before run(). */
+    void setMeshDir(const char *dir)
+    {
+        meshdir = dir!=NULL ? dir : "";
+    }
+
+    /* Starts the cubatures of each point from the partitions of the nearest point already
+       finished (if on is nonzero). Must be called before run(). */
+    void setWarmStart(int on)
+    {
+        warm = on;
+        meshes.assign(on ? done.size() : 0, FigMesh());
+    }
+
+    /* Results of the points, NaN for those not finished. Points taken from the table have
+       shared = 1, and the number of evaluations and error estimate of the process that
+       computed them. */
+    const std::vector<double> &losses() const { return di; }
+    const std::vector<double> &thetas() const { return theta; }
+    const std::vector<double> &errors() const { return err; }
+    const std::vector<double> &times() const { return seconds; }
+    const std::vector<size_t> &evaluations() const { return evals; }
+    const std::vector<unsigned char> &finished() const { return done; }
+    const std::vector<unsigned char> &fromTable() const { return shared; }
+
+private:
+    std::vector<double>         par, cost, di, theta, err, seconds;
+    std::vector<size_t>         evals;
+    std::vector<unsigned char>  done, shared;
+    std::vector<size_t>         order;
+    ResultTable                 *table;
+    uint64_t                    dom;
+    std::string                 meshdir;
+    int                         warm;
+    std::vector<FigMesh>        meshes;
+    std::deque<std::pair<size_t,size_t> >   pending;
+    std::atomic<size_t>         ncompleted;
+    std::atomic<bool>           stop, running;
+    mutable std::mutex          mtx;
+    double                      costdone, errsum, errmax, elapsedEnd;
+    std::chrono::steady_clock::time_point   start;
+
+    double elapsed() const
+    {
+        return std::chrono::duration<double>(
+            std::chrono::steady_clock::now()-start).count();
+    }
+
+    static int sweepMaxThreads()
+    {
+        #ifdef _OPENMP
+        return omp_get_max_threads();
+        #else
+        return 1;
+        #endif
+    }
+
+    /* Solves the point ind and, if slot is given, publishes it in the table */
+    void solve(size_t ind, const size_t *slot = NULL)
+    {
+        FigMesh     mesh;
+        std::string file;
+        int         swap = par[3*ind]>0.5;
+        int         usemesh = warm || !meshdir.empty();
+        double      t0 = elapsed();
+        double      val[4];
+
+        /* Partitions are stored as for the points of the table, with q <= 0.5 */
+        if(!meshdir.empty())
+        {
+            file = meshFile(ind);
+            mesh.load(file.c_str());
+        }
+        if(warm && mesh.m2D.empty()) nearestMesh(ind, mesh);
+        if(swap) mesh.mirror();
+
+        FigLoss loss(&par[3*ind], usemesh ? &mesh : NULL);
+
+        val[0] = minimizeTheta(loss, val+1);
+        val[2] = loss.error();
+        val[3] = (double)loss.evaluations();
+        if(usemesh)
+        {
+            if(swap) mesh.mirror();
+            if(!meshdir.empty()) mesh.save(file.c_str());
+            if(warm)
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                meshes[ind] = mesh;
+            }
+        }
+        if(slot!=NULL) table->publish(*slot, val, 4);
+        finish(ind, val, elapsed()-t0, 0);
+    }
+
+    void finish(size_t ind, const double *val, double now, int fromtab)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        di[ind]      = val[0];
+        theta[ind]   = val[1];
+        err[ind]     = val[2];
+        evals[ind]   = (size_t)val[3];
+        seconds[ind] = now;
+        done[ind]    = 1;
+        shared[ind]  = (unsigned char)fromtab;
+        costdone    += cost[ind];
+        errsum      += err[ind];
+        if(err[ind]>errmax) errmax = err[ind];
+        ncompleted++;
+    }
+
+    /* Point ind as stored in the table. Since the losses are unchanged when swapping the
+       stimuli, i.e., [q,rho1,rho2] by [1-q,rho2,rho1], points are stored with q <= 0.5. */
+    void tableKey(size_t ind, double *key) const
+    {
+        const double    *p = &par[3*ind];
+        int             swap = p[0]>0.5;
+
+        key[0] = swap ? 1-p[0] : p[0];
+        key[1] = p[swap ? 2 : 1];
+        key[2] = p[swap ? 1 : 2];
+    }
+
+    /* Copies the partitions of the finished point nearest to ind, if any lies within
+       SWEEP_WARMRADIUS */
+    void nearestMesh(size_t ind, FigMesh &mesh) const
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        double      key[3], other[3], dist, best = SWEEP_WARMRADIUS;
+        size_t      k, nearest = meshes.size();
+        int         j;
+
+        tableKey(ind, key);
+        for(k=0; k<meshes.size(); k++)
+        {
+            if(meshes[k].m2D.empty()) continue;
+            tableKey(k, other);
+            for(j=0, dist=0; j<3; j++) dist = std::max(dist, std::fabs(key[j]-other[j]));
+            if(dist<=best)
+            {
+                best    = dist;
+                nearest = k;
+            }
+        }
+        if(nearest<meshes.size()) mesh = meshes[nearest];
+    }
+
+    /* File of the partitions of the cell of the point ind, named after the centre of the
+       cell of the point as stored in the table */
+    std::string meshFile(size_t ind) const
+    {
+        double  key[3];
+        char    name[64];
+        int     k;
+
+        tableKey(ind, key);
+        for(k=0; k<3; k++)
+            key[k] = SWEEP_MESHCELL*std::floor(key[k]/SWEEP_MESHCELL+0.5) + 0.0;
+        snprintf(name, sizeof(name), "/Fig4_%.3f_%.3f_%.3f.mesh", key[0], key[1], key[2]);
+        return meshdir + name;
+    }
+
+    void acquire(size_t ind)
+    {
+        double  key[3], val[RT_NVAL];
+        size_t  slot;
+
+        tableKey(ind, key);
+        switch(table->acquire(dom, key, 3, val, &slot))
+        {
+        case RT_HIT:
+            finish(ind, val, 0, 1);
+            break;
+        case RT_OWNED:
+            solve(ind, &slot);
+            break;
+        case RT_BUSY:
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                pending.push_back(std::make_pair(ind, slot));
+            }
+            break;
+        default:
+            solve(ind);
+        }
+    }
+
+    /* Waits for the points being computed by other processes, taking over those whose
+       claims are released or whose owners die */
+    void awaitPending(int nthreads)
+    {
+        #pragma omp parallel num_threads(nthreads)
+        {
+            std::pair<size_t,size_t>    item;
+            double                      val[RT_NVAL];
+            int                         more = 1;
+
+            while(more)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    more = !pending.empty() && !stop.load();
+                    if(more)
+                    {
+                        item = pending.front();
+                        pending.pop_front();
+                    }
+                }
+                if(!more) break;
+
+                switch(table->poll(item.second, val))
+                {
+                case RT_HIT:
+                    finish(item.first, val, 0, 1);
+                    break;
+                case RT_OWNED:
+                    solve(item.first, &item.second);
+                    break;
+                default:
+                    {
+                        std::lock_guard<std::mutex> lock(mtx);
+                        pending.push_back(item);
+                    }
+                    ResultTable::sleepNs(20000000);
+                }
+            }
+        }
+    }
+};
+
+#endif
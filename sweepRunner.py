@@ -0,0 +1,311 @@
+# This software is provided as supplementary material for the following publication:
+#
+# Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+# populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+#
+# Should you use this code, I kindly request you to cite the aforementioened publication.
+#
+# DESCRIPTION:
+#
+# Progress reports and cancellation for long sweeps, both for the sweeps of Fig7code.py and
+# for the native sweep runner of Figure 4 (sweepRunner.cpp).
+#
+# SweepProgress keeps track of the points of a sweep computed in Python. Its method
+# report() returns a dict with the number of points completed and in total, the elapsed
+# time, the estimated time to finish (from the predicted relative cost of each point, by
+# default equal for all points), and the sum and maximum of the error estimates of the
+# finished points.
+#
+# NativeSweep runs the sweep of dinidlGaussThetaT over points [q,rho1,rho2] of Figure 4 in
+# a background thread of the shared library, while the calling thread reports the progress
+# and checks for cancellation. Cancelled sweeps return all the points finished so far.
+# Points start in decreasing order of the cost predicted from previous runs (see
+# sweepRunner.hpp), and partition splits sweeps into chunks of similar predicted cost.
+#
+# ResultTable gives access to the tables of results shared by all processes of the
+# machine (see resultTable.hpp). Its method compute returns the results of a point from the
+# table, waits for them if another process is computing them, or else computes them and
+# publishes them for the others. NativeSweep.run shares its results through a table if
+# given.
+#
+# DEPENDENCIES:
+#
+# The software requires the packages
+#
+# - ctypes
+# - numpy
+# - threading
+# - time
+#
+# NativeSweep requires the shared library, which can be compiled as follows
+#
+#   g++ -std=c++11 -O2 -fopenmp -shared -fPIC -o libsweepRunner.so sweepRunner.cpp -lrt
+#
+# The OpenMP flags are optional.
+#
+# EXAMPLE:
+#
+# import threading
+# import sweepRunner as SR
+#
+# cancel = threading.Event()
+# res = SR.NativeSweep().run([[0.3,0.5,0.5],[0.2,0.8,-0.4]], progress=print, cancel=cancel)
+#
+# In Fig7code.py, resultsFig7a/b/c accept the same arguments progress and cancel.
+#
+# table = SR.ResultTable('/dinidl')
+# res = SR.NativeSweep().run([[0.3,0.5,0.5],[0.7,0.5,0.5]], table=table)
+#
+# VERSION CONTROL
+#
+# V1.000 (19 Oct 2026)
+# V1.001 Shared result tables (19 Oct 2026)
+# V1.002 Stored partitions of the cubatures (19 Oct 2026)
+# V1.003 Cubatures started from neighbouring points (19 Oct 2026)
+#
+# Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+#
+# LICENSE
+#
+# Copyright (c) 2017, Hugo Gabriel Eyherabide
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without modification,
+# are permitted provided that the following conditions are met:
+#
+# 1.  Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+#
+# 2.  Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+#
+# 3.  Neither the name of the copyright holder nor the names of its contributors
+#     may be used to endorse or promote products derived from this software
+#     without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+# IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+# INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+# NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+# WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+# OF SUCH DAMAGE.
+
+
+import ctypes
+import os
+import threading
+import time
+import numpy
+
+# Progress of a sweep computed in Python
+class SweepProgress:
+
+    def __init__(self,total,cost=None):
+        self.total = total
+        self.cost = list(cost) if cost is not None else [1.0]*total
+        self.completed = 0
+        self.costdone = 0.0
+        self.errsum = 0.0
+        self.errmax = 0.0
+        self.start = time.time()
+
+    # Records that the point ind has finished with error estimate err
+    def done(self,ind,err=0.0):
+        self.completed += 1
+        self.costdone += self.cost[ind]
+        self.errsum += err
+        self.errmax = max(self.errmax,err)
+
+    def report(self):
+        elapsed = time.time()-self.start
+        eta = elapsed*(sum(self.cost)-self.costdone)/self.costdone if self.costdone>0 else float('nan')
+        return {'completed':self.completed,'total':self.total,'elapsed':elapsed,'eta':eta,
+                'errsum':self.errsum,'errmax':self.errmax}
+
+
+# Same layout as SweepProgress in sweepRunner.hpp
+class _NativeProgress(ctypes.Structure):
+    _fields_ = [('completed',ctypes.c_double),('total',ctypes.c_double),
+                ('elapsed',ctypes.c_double),('eta',ctypes.c_double),
+                ('errsum',ctypes.c_double),('errmax',ctypes.c_double),
+                ('running',ctypes.c_int),('cancelled',ctypes.c_int)]
+
+
+# Sweep of Figure 4 in the shared library
+def _loadLibrary(libpath=None):
+    if libpath is None:
+        libpath = os.path.join(os.path.dirname(os.path.abspath(__file__)),'libsweepRunner.so')
+    return ctypes.CDLL(libpath)
+
+
+class NativeSweep:
+
+    def __init__(self,libpath=None):
+        lib = _loadLibrary(libpath)
+        dptr = numpy.ctypeslib.ndpointer(dtype=numpy.float64,flags='C_CONTIGUOUS')
+        lib.sweepCreate.restype = ctypes.c_void_p
+        lib.sweepCreate.argtypes = [dptr,ctypes.c_size_t]
+        lib.sweepSetCost.argtypes = [ctypes.c_void_p,dptr]
+        lib.sweepRun.argtypes = [ctypes.c_void_p,ctypes.c_int]
+        lib.sweepCancel.argtypes = [ctypes.c_void_p]
+        lib.sweepProgress.argtypes = [ctypes.c_void_p,ctypes.POINTER(_NativeProgress)]
+        lib.sweepResults.argtypes = [ctypes.c_void_p,dptr,dptr,dptr,dptr,dptr,
+                                     numpy.ctypeslib.ndpointer(dtype=numpy.uint8,flags='C_CONTIGUOUS')]
+        lib.sweepFree.argtypes = [ctypes.c_void_p]
+        lib.sweepUseHistory.argtypes = [ctypes.c_void_p,ctypes.c_char_p]
+        lib.sweepSaveHistory.argtypes = [ctypes.c_void_p,ctypes.c_char_p]
+        lib.sweepUseTable.argtypes = [ctypes.c_void_p,ctypes.c_void_p]
+        lib.sweepUseMeshes.argtypes = [ctypes.c_void_p,ctypes.c_char_p]
+        lib.sweepWarmStart.argtypes = [ctypes.c_void_p,ctypes.c_int]
+        lib.sweepShared.restype = ctypes.c_size_t
+        lib.sweepShared.argtypes = [ctypes.c_void_p,numpy.ctypeslib.ndpointer(dtype=numpy.uint8,flags='C_CONTIGUOUS')]
+        lib.sweepPartitionPoints.restype = ctypes.c_double
+        lib.sweepPartitionPoints.argtypes = [dptr,ctypes.c_size_t,ctypes.c_char_p,ctypes.c_uint,
+                                             numpy.ctypeslib.ndpointer(dtype=numpy.uintc,flags='C_CONTIGUOUS')]
+        self.lib = lib
+
+    # Solves the points par (rows [q,rho1,rho2]) with nthreads threads (0 for the default).
+    # Every interval seconds, progress (if given) is called with a dict as in SweepProgress,
+    # and the sweep is cancelled when cancel (e.g., a threading.Event) is set. Returns a
+    # dict with arrays di, theta, err, evals, seconds and done, and the final progress.
+    # Points start in decreasing order of predicted cost, given by cost or else predicted
+    # from the costs recorded in the file history, to which those of this run are added.
+    # If table (a ResultTable) is given, points finished by other processes are taken from
+    # it, and res['shared'] indicates which ones. If meshes (a folder) is given, the cubatures
+    # start from the partitions stored there by previous runs with similar points. If warm is
+    # True, they start from the partitions of the nearest point finished in the sweep.
+    def run(self,par,nthreads=0,progress=None,cancel=None,interval=1.0,cost=None,history=None,table=None,meshes=None,warm=False):
+        par = numpy.ascontiguousarray(par,dtype=numpy.float64).reshape(-1,3)
+        npt = par.shape[0]
+        sweep = self.lib.sweepCreate(par,npt)
+        worker = None
+        try:
+            if cost is not None:
+                self.lib.sweepSetCost(sweep,numpy.ascontiguousarray(cost,dtype=numpy.float64))
+            else:
+                self.lib.sweepUseHistory(sweep,history.encode() if history is not None else b'')
+            if table is not None:
+                self.lib.sweepUseTable(sweep,table.handle)
+            if meshes is not None:
+                self.lib.sweepUseMeshes(sweep,meshes.encode())
+            if warm:
+                self.lib.sweepWarmStart(sweep,1)
+            worker = threading.Thread(target=self.lib.sweepRun,args=(sweep,nthreads),daemon=True)
+            worker.start()
+            while worker.is_alive():
+                worker.join(interval)
+                if cancel is not None and cancel.is_set():
+                    self.lib.sweepCancel(sweep)
+                if progress is not None and worker.is_alive():
+                    progress(self._report(sweep))
+            res = {key:numpy.full(npt,numpy.nan) for key in ['di','theta','err','evals','seconds']}
+            res['done'] = numpy.zeros(npt,dtype=numpy.uint8)
+            self.lib.sweepResults(sweep,res['di'],res['theta'],res['err'],res['evals'],res['seconds'],res['done'])
+            res['done'] = res['done'].astype(bool)
+            res['shared'] = numpy.zeros(npt,dtype=numpy.uint8)
+            self.lib.sweepShared(sweep,res['shared'])
+            res['shared'] = res['shared'].astype(bool)
+            res['progress'] = self._report(sweep)
+            if history is not None:
+                self.lib.sweepSaveHistory(sweep,history.encode())
+            if progress is not None:
+                progress(res['progress'])
+        finally:
+            # The sweep is freed only once the worker has returned. If progress or Ctrl-C
+            # raised, the sweep is cancelled first; if the wait is interrupted again, the
+            # sweep is left allocated rather than freed while in use.
+            if worker is not None and worker.is_alive():
+                self.lib.sweepCancel(sweep)
+                worker.join()
+            self.lib.sweepFree(sweep)
+        return res
+
+    # Splits the points par into nchunks chunks of similar predicted cost, for running them in
+    # different machines. Returns the chunk of each point (from 0 to nchunks-1).
+    def partition(self,par,nchunks,history=None):
+        par = numpy.ascontiguousarray(par,dtype=numpy.float64).reshape(-1,3)
+        chunk = numpy.zeros(par.shape[0],dtype=numpy.uintc)
+        self.lib.sweepPartitionPoints(par,par.shape[0],history.encode() if history is not None else None,nchunks,chunk)
+        return chunk
+
+    def _report(self,sweep):
+        prog = _NativeProgress()
+        self.lib.sweepProgress(sweep,ctypes.byref(prog))
+        return {key:getattr(prog,key) for key,_ in _NativeProgress._fields_}
+
+
+# Table of results shared by the processes of the machine, created if it does not exist
+# (see resultTable.hpp). Each computation is identified by a domain, a string that must
+# describe it and its settings, and each point by a list of at most 8 parameters.
+class ResultTable:
+
+    HIT, OWNED, BUSY, FULL = 0, 1, 2, 3
+    NVAL = 8
+
+    def __init__(self,name='/dinidl',capacity=1<<16,libpath=None):
+        lib = _loadLibrary(libpath)
+        dptr = numpy.ctypeslib.ndpointer(dtype=numpy.float64,flags='C_CONTIGUOUS')
+        lib.tableOpen.restype = ctypes.c_void_p
+        lib.tableOpen.argtypes = [ctypes.c_char_p,ctypes.c_size_t]
+        lib.tableClose.argtypes = [ctypes.c_void_p]
+        lib.tableUnlink.argtypes = [ctypes.c_char_p]
+        lib.tableDomain.restype = ctypes.c_uint64
+        lib.tableDomain.argtypes = [ctypes.c_char_p]
+        lib.tableAcquire.argtypes = [ctypes.c_void_p,ctypes.c_uint64,dptr,ctypes.c_uint,dptr,
+                                     ctypes.POINTER(ctypes.c_size_t)]
+        lib.tablePoll.argtypes = [ctypes.c_void_p,ctypes.c_size_t,dptr]
+        lib.tablePublish.argtypes = [ctypes.c_void_p,ctypes.c_size_t,dptr,ctypes.c_uint]
+        lib.tableRelease.argtypes = [ctypes.c_void_p,ctypes.c_size_t]
+        lib.tableUsed.restype = ctypes.c_size_t
+        lib.tableUsed.argtypes = [ctypes.c_void_p,ctypes.POINTER(ctypes.c_size_t)]
+        self.lib = lib
+        self.name = name
+        self.handle = lib.tableOpen(name.encode(),capacity)
+        if not self.handle:
+            raise OSError('Cannot open the result table '+name)
+
+    # Returns the results of the point key of domain as a list of nval values: from the table
+    # if finished, after waiting (polling every interval seconds) if another process is
+    # computing them, or else as given by compute(), which are then published.
+    def compute(self,domain,key,compute,nval=NVAL,interval=0.05):
+        dom = self.lib.tableDomain(domain.encode())
+        key = numpy.ascontiguousarray(key,dtype=numpy.float64)
+        val = numpy.zeros(self.NVAL)
+        slot = ctypes.c_size_t(0)
+        state = self.lib.tableAcquire(self.handle,dom,key,len(key),val,ctypes.byref(slot))
+        while state==self.BUSY:
+            time.sleep(interval)
+            state = self.lib.tablePoll(self.handle,slot.value,val)
+        if state==self.HIT:
+            return [float(v) for v in val[:nval]]
+        try:
+            res = [float(v) for v in compute()]
+        except BaseException:
+            if state==self.OWNED:
+                self.lib.tableRelease(self.handle,slot.value)
+            raise
+        if state==self.OWNED:
+            self.lib.tablePublish(self.handle,slot.value,numpy.ascontiguousarray(res,dtype=numpy.float64),len(res))
+        return res
+
+    # Number of entries in use and in total
+    def usage(self):
+        cap = ctypes.c_size_t(0)
+        return self.lib.tableUsed(self.handle,ctypes.byref(cap)),cap.value
+
+    def close(self):
+        if self.handle:
+            self.lib.tableClose(self.handle)
+            self.handle = None
+
+    # Removes the table from the system, once all processes close it
+    def unlink(self):
+        self.lib.tableUnlink(self.name.encode())
+
+    def __del__(self):
+        self.close()
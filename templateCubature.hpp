@@ -0,0 +1,560 @@
+/*
+ This software is provided as supplementary material for the following publication:
+
+ Eyherabide HG, Disambiguating the role of noise correlations when decoding neural
+ populations together, arXiv (2017), https://arxiv.org/abs/1608.05501v2.
+
+ Should you use this code, I kindly request you to cite the aforementioened publication.
+
+ DESCRIPTION:
+
+ Header-only adaptive cubature and one-dimensional minimization, written as C++ templates
+ parameterized on the integrand and on the number of dimensions.
+
+ The mex-files based on the Cubature and GSL libraries pass the integrand as a function
+ pointer and its parameters as a pointer to void, so the compiler cannot inline the
+ integrand into the loops that apply the integration rules, nor specialize it for the
+ model at hand. Here, the integrand is any class with a member
+
+   double operator()(const double *x) const
+
+ and the rules are instantiated for it and for the number of dimensions D, which are known
+ at compile time. The integrand is thereby inlined in the rules, the loops over the
+ dimensions are unrolled, and the constant parameters of the integrand can be folded.
+
+ The cubature follows the algorithm of hcubature in the Cubature library: the region with
+ the largest error estimate is repeatedly bisected along the dimension in which the
+ integrand varies the most, until the total error satisfies the requested absolute or
+ relative tolerance or the number of evaluations exceeds the given maximum. Regions are
+ integrated with the Genz-Malik rule of degree 7 (D >= 2) or the Gauss-Kronrod rule with
+ 15 points (D = 1). The final partition of the domain is available to the caller.
+
+ The integration can also start from a given partition of the domain, such as the final
+ partition of a similar integrand, whose regions are evaluated again and then refined.
+ Regions whose error estimates are far below the tolerance are merged first, so that
+ reused partitions adapt to the new integrand in both directions.
+ Partitions can be written to and read from files with cubatureWrite and cubatureRead,
+ so that they can be reused in later runs.
+
+ The minimization follows dinidlGaussTheta: the minimum is first bracketed by doubling the
+ initial interval and then refined with Brent's method, as implemented in GSL.
+
+ This file is included by the mex-files that need it, and requires no external library.
+
+ VERSION CONTROL
+
+ V1.000 (19 Oct 2026)
+ V1.001 Integration from a given partition, and partitions stored in files (19 Oct 2026)
+ V1.002 Partitions coarsened when reused (19 Oct 2026)
+
+ Should you find bugs, please contact Hugo Gabriel Eyherabide (neuralinfo@eyherabidehg.com)
+
+ LICENSE
+
+ Copyright (c) 2017, Hugo Gabriel Eyherabide
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+
+ 1.  Redistributions of source code must retain the above copyright notice,
+     this list of conditions and the following disclaimer.
+
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+     this list of conditions and the following disclaimer in the documentation
+     and/or other materials provided with the distribution.
+
+ 3.  Neither the name of the copyright holder nor the names of its contributors
+     may be used to endorse or promote products derived from this software
+     without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ OF SUCH DAMAGE.
+*/
+
+
+#ifndef TEMPLATECUBATURE_HPP
+#define TEMPLATECUBATURE_HPP
+
+#include<cmath>
+#include<cstddef>
+#include<cstdio>
+#include<vector>
+#include<map>
+#include<algorithm>
+
+/* Hyperrectangle with centre c and half-widths h, together with the estimates of the
+   integral and its error within, and the dimension along which it should be split */
+template<unsigned D>
+struct CubatureRegion
+{
+    double      c[D];
+    double      h[D];
+    double      val;
+    double      err;
+    unsigned    split;
+};
+
+/* Orders regions so that the region with the largest error is on top of the heap */
+template<unsigned D>
+inline bool cubatureLess(const CubatureRegion<D> &a, const CubatureRegion<D> &b)
+{
+    return a.err<b.err;
+}
+
+/* Factor by which the error estimate of a region exceeds the sum of those of its halves,
+   roughly 2^8 for the rules of degree 7 */
+#define CUBATURE_MERGE_FACTOR 256
+
+/* Merges pairs of adjacent regions of the same size whose union is a region, if the sum
+   of their error estimates times CUBATURE_MERGE_FACTOR is below errmax. Each region is
+   merged at most once. Regions produced by bisection have dyadic centres and half-widths,
+   so adjacent regions are found by exact comparison. */
+template<unsigned D>
+void cubatureCoarsen(std::vector< CubatureRegion<D> > &reg, double errmax)
+{
+    std::map< std::vector<double>, size_t > index;
+    std::vector<unsigned char>              merged(reg.size(), 0);
+    std::vector<double>                     key(2*D);
+    std::map< std::vector<double>, size_t >::iterator   it;
+    size_t                                  ind, out;
+    unsigned                                dim;
+
+    if(!(errmax>0)) return;
+    for(ind=0; ind<reg.size(); ind++)
+    {
+        std::copy(reg[ind].c, reg[ind].c+D, key.begin());
+        std::copy(reg[ind].h, reg[ind].h+D, key.begin()+D);
+        index[key] = ind;
+    }
+
+    for(ind=0; ind<reg.size(); ind++)
+    {
+        if(merged[ind] || !(CUBATURE_MERGE_FACTOR*reg[ind].err<errmax)) continue;
+        std::copy(reg[ind].c, reg[ind].c+D, key.begin());
+        std::copy(reg[ind].h, reg[ind].h+D, key.begin()+D);
+        for(dim=0; dim<D; dim++)
+        {
+            key[dim] = reg[ind].c[dim] + 2*reg[ind].h[dim];
+            it = index.find(key);
+            key[dim] = reg[ind].c[dim];
+            if(it==index.end() || merged[it->second]) continue;
+            if(!(CUBATURE_MERGE_FACTOR*(reg[ind].err+reg[it->second].err)<errmax)) continue;
+
+            merged[it->second] = 1;
+            reg[ind].c[dim]   += reg[ind].h[dim];
+            reg[ind].h[dim]   *= 2;
+            reg[ind].val      += reg[it->second].val;
+            reg[ind].err       = CUBATURE_MERGE_FACTOR*(reg[ind].err+reg[it->second].err);
+            break;
+        }
+        if(dim<D) merged[ind] = 2;
+    }
+
+    for(ind=0, out=0; ind<reg.size(); ind++)
+        if(merged[ind]!=1) reg[out++] = reg[ind];
+    reg.resize(out);
+}
+
+template<unsigned D, class F>
+class Cubature
+{
+public:
+    Cubature(const F &fun) : f(fun), neval(0) {}
+
+    /* Integrates f over the hyperrectangle [xmin,xmax]. Returns 0 if the requested
+       tolerance was attained, and 1 if the maximum number of evaluations was reached
+       first. A value of zero for maxEval means no limit. */
+    int integrate(const double *xmin, const double *xmax, size_t maxEval, double reqAbsError, double reqRelError, double &val, double &err)
+    {
+        CubatureRegion<D>   reg;
+        unsigned            ind;
+
+        for(ind=0; ind<D; ind++)
+        {
+            reg.c[ind] = 0.5*(xmin[ind]+xmax[ind]);
+            reg.h[ind] = 0.5*(xmax[ind]-xmin[ind]);
+        }
+        heap.clear();
+        neval = 0;
+        evalRegion(reg);
+        heap.push_back(reg);
+        return refine(maxEval, reqAbsError, reqRelError, val, err);
+    }
+
+    /* Integrates f as integrate() does, but starting from the partition start of the
+       domain (e.g., the regions of a previous integration of a similar integrand) instead
+       of the whole domain. Before the regions of start are evaluated again, pairs of
+       regions are merged if their error estimates, as stored in start, suggest that the
+       merged region would still satisfy the tolerance (see cubatureCoarsen), so that the
+       partition does not keep growing when reused over and over. */
+    int integrate(const std::vector< CubatureRegion<D> > &start, size_t maxEval, double reqAbsError, double reqRelError, double &val, double &err)
+    {
+        size_t  ind;
+        double  vstart = 0;
+
+        if(&start!=&heap) heap = start;
+        for(ind=0; ind<heap.size(); ind++) vstart += heap[ind].val;
+        if(!heap.empty()) cubatureCoarsen<D>(heap, std::max(reqAbsError, reqRelError*std::fabs(vstart))/heap.size());
+        neval = 0;
+        for(ind=0; ind<heap.size(); ind++) evalRegion(heap[ind]);
+        return refine(maxEval, reqAbsError, reqRelError, val, err);
+    }
+
+    /* Regions of the last partition of the domain */
+    const std::vector< CubatureRegion<D> > &regions() const { return heap; }
+
+    /* Number of evaluations of the integrand in the last call */
+    size_t evaluations() const { return neval; }
+
+protected:
+    const F                             &f;
+    std::vector< CubatureRegion<D> >    heap;
+    size_t                              neval;
+
+    /* Bisects the regions with the largest errors until the tolerance or the maximum number
+       of evaluations is reached. As in hcubature, each round bisects as many regions as
+       needed for the remaining ones to satisfy the tolerance on their own. */
+    int refine(size_t maxEval, double reqAbsError, double reqRelError, double &val, double &err)
+    {
+        std::vector< CubatureRegion<D> >    cut;
+        CubatureRegion<D>                   reg;
+        size_t                              ind;
+        unsigned                            dim;
+        double                              vrest, erest;
+
+        std::make_heap(heap.begin(), heap.end(), cubatureLess<D>);
+        for(;;)
+        {
+            val = err = 0;
+            for(ind=0; ind<heap.size(); ind++)
+            {
+                val += heap[ind].val;
+                err += heap[ind].err;
+            }
+            if(err<=reqAbsError || err<=reqRelError*std::fabs(val)) return 0;
+            if(maxEval && neval>=maxEval) return 1;
+
+            cut.clear();
+            vrest = val;
+            erest = err;
+            do
+            {
+                std::pop_heap(heap.begin(), heap.end(), cubatureLess<D>);
+                reg = heap.back();
+                heap.pop_back();
+                vrest -= reg.val;
+                erest -= reg.err;
+
+                dim = reg.split;
+                reg.h[dim] *= 0.5;
+                reg.c[dim] -= reg.h[dim];
+                cut.push_back(reg);
+                reg.c[dim] += 2*reg.h[dim];
+                cut.push_back(reg);
+            }
+            while(!heap.empty() && !(erest<=reqAbsError || erest<=reqRelError*std::fabs(vrest)));
+
+            for(ind=0; ind<cut.size(); ind++)
+            {
+                evalRegion(cut[ind]);
+                heap.push_back(cut[ind]);
+                std::push_heap(heap.begin(), heap.end(), cubatureLess<D>);
+            }
+        }
+    }
+
+    void evalRegion(CubatureRegion<D> &reg)
+    {
+        if(D==1) evalGaussKronrod(reg); else evalGenzMalik(reg);
+    }
+
+    /* Gauss-Kronrod rule with 15 points, whose 7-point Gauss subset estimates the error */
+    void evalGaussKronrod(CubatureRegion<D> &reg)
+    {
+        static const double xk[8] = {0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+                                     0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+                                     0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+                                     0.207784955007898467600689403773245, 0.000000000000000000000000000000000};
+        static const double wk[8] = {0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+                                     0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+                                     0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+                                     0.204432940075298892414161999234649, 0.209482141084727828012999174891714};
+        static const double wg[4] = {0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+                                     0.381830050505118944950369775488975, 0.417959183673469387755102040816327};
+        double      x[D];
+        double      fc, f1, f2;
+        double      resk, resg;
+        unsigned    ind;
+
+        x[0] = reg.c[0];
+        fc   = f(x);
+        resk = wk[7]*fc;
+        resg = wg[3]*fc;
+        for(ind=0; ind<7; ind++)
+        {
+            x[0] = reg.c[0]-reg.h[0]*xk[ind];
+            f1   = f(x);
+            x[0] = reg.c[0]+reg.h[0]*xk[ind];
+            f2   = f(x);
+            resk += wk[ind]*(f1+f2);
+            if(ind%2) resg += wg[ind/2]*(f1+f2);
+        }
+        neval += 15;
+        reg.val   = resk*reg.h[0];
+        reg.err   = std::fabs((resk-resg)*reg.h[0]);
+        reg.split = 0;
+    }
+
+    /* Genz-Malik rule of degree 7, with an embedded rule of degree 5 to estimate the error
+       and fourth differences along each dimension to choose the dimension to split */
+    void evalGenzMalik(CubatureRegion<D> &reg)
+    {
+        const double lambda2 = 0.3585685828003180919906451539079374954541;
+        const double lambda4 = 0.9486832980505137995996680633298155601160;
+        const double lambda5 = 0.6882472016116852977216287342936235251269;
+        const double weight1 = (12824.0-9120.0*D+400.0*D*D)/19683.0;
+        const double weight2 = 980.0/6561.0;
+        const double weight3 = (1820.0-400.0*D)/19683.0;
+        const double weight4 = 200.0/19683.0;
+        const double weight5 = 6859.0/19683.0/(double)(1u<<D);
+        const double weightE1 = (729.0-950.0*D+50.0*D*D)/729.0;
+        const double weightE2 = 245.0/486.0;
+        const double weightE3 = (265.0-100.0*D)/1458.0;
+        const double weightE4 = 25.0/729.0;
+        const double ratio = (lambda2*lambda2)/(lambda4*lambda4);
+        double      x[D];
+        double      f0, fa, fb, diff, maxdiff = 0;
+        double      sum2 = 0, sum3 = 0, sum4 = 0, sum5 = 0;
+        double      vol = 1, res7, res5;
+        unsigned    i, j, k, sgn;
+
+        for(i=0; i<D; i++)
+        {
+            x[i] = reg.c[i];
+            vol *= 2*reg.h[i];
+        }
+        f0 = f(x);
+        reg.split = 0;
+
+        for(i=0; i<D; i++)
+        {
+            x[i] = reg.c[i]-lambda2*reg.h[i]; fa  = f(x);
+            x[i] = reg.c[i]+lambda2*reg.h[i]; fa += f(x);
+            x[i] = reg.c[i]-lambda4*reg.h[i]; fb  = f(x);
+            x[i] = reg.c[i]+lambda4*reg.h[i]; fb += f(x);
+            x[i] = reg.c[i];
+            sum2 += fa;
+            sum3 += fb;
+            diff  = std::fabs(fa-2*f0-ratio*(fb-2*f0));
+            if(diff>maxdiff*(1+1E-12) || (diff>=maxdiff*(1-1E-12) && reg.h[i]>reg.h[reg.split]))
+            {
+                maxdiff   = diff;
+                reg.split = i;
+            }
+        }
+
+        for(i=0; i<D; i++)
+            for(j=i+1; j<D; j++)
+                for(sgn=0; sgn<4; sgn++)
+                {
+                    x[i] = reg.c[i] + (sgn&1 ? lambda4 : -lambda4)*reg.h[i];
+                    x[j] = reg.c[j] + (sgn&2 ? lambda4 : -lambda4)*reg.h[j];
+                    sum4 += f(x);
+                    x[i] = reg.c[i];
+                    x[j] = reg.c[j];
+                }
+
+        for(k=0; k<(1u<<D); k++)
+        {
+            for(i=0; i<D; i++) x[i] = reg.c[i] + (k>>i&1 ? lambda5 : -lambda5)*reg.h[i];
+            sum5 += f(x);
+        }
+
+        neval += 1 + 4*D + 2*D*(D-1) + (1u<<D);
+        res7 = vol*(weight1*f0 + weight2*sum2 + weight3*sum3 + weight4*sum4 + weight5*sum5);
+        res5 = vol*(weightE1*f0 + weightE2*sum2 + weightE3*sum3 + weightE4*sum4);
+        reg.val = res7;
+        reg.err = std::fabs(res5-res7);
+    }
+};
+
+/* Writes the partition reg as a line "D n" followed by one line per region with its centre,
+   half-widths, and estimates of the integral and its error. Returns 0 on failure. */
+template<unsigned D>
+int cubatureWrite(FILE *fid, const std::vector< CubatureRegion<D> > &reg)
+{
+    size_t      ind;
+    unsigned    k;
+
+    if(fprintf(fid, "%u %zu\n", D, reg.size())<0) return 0;
+    for(ind=0; ind<reg.size(); ind++)
+    {
+        for(k=0; k<D; k++) fprintf(fid, "%.17g ", reg[ind].c[k]);
+        for(k=0; k<D; k++) fprintf(fid, "%.17g ", reg[ind].h[k]);
+        fprintf(fid, "%.17g %.17g\n", reg[ind].val, reg[ind].err);
+    }
+    return !ferror(fid);
+}
+
+/* Reads a partition written by cubatureWrite. Returns 0, leaving reg empty, if the file
+   does not contain a valid partition of D dimensions. */
+template<unsigned D>
+int cubatureRead(FILE *fid, std::vector< CubatureRegion<D> > &reg)
+{
+    unsigned    dim, k;
+    size_t      num, ind;
+    int         ok;
+
+    reg.clear();
+    if(fscanf(fid, "%u %zu", &dim, &num)!=2 || dim!=D) return 0;
+    reg.resize(num);
+    for(ind=0; ind<num; ind++)
+    {
+        ok = 1;
+        for(k=0; k<D && ok; k++) ok = fscanf(fid, "%lf", reg[ind].c+k)==1;
+        for(k=0; k<D && ok; k++) ok = fscanf(fid, "%lf", reg[ind].h+k)==1 && reg[ind].h[k]>0;
+        ok = ok && fscanf(fid, "%lf %lf", &reg[ind].val, &reg[ind].err)==2;
+        if(!ok)
+        {
+            reg.clear();
+            return 0;
+        }
+        reg[ind].split = 0;
+    }
+    return 1;
+}
+
+/* Integrates f over [xmin,xmax] in D dimensions, with the same arguments as hcubature */
+template<unsigned D, class F>
+inline int hcubatureT(const F &f, const double *xmin, const double *xmax, size_t maxEval, double reqAbsError, double reqRelError, double &val, double &err)
+{
+    Cubature<D,F>   cub(f);
+
+    return cub.integrate(xmin, xmax, maxEval, reqAbsError, reqRelError, val, err);
+}
+
+/* Interval test of gsl_min_test_interval */
+inline bool minimizeConverged(double lower, double upper, double epsabs, double epsrel)
+{
+    double  minabs = (lower>0 && upper>0) || (lower<0 && upper<0) ? std::min(std::fabs(lower), std::fabs(upper)) : 0;
+
+    return std::fabs(upper-lower) < epsabs + epsrel*minabs;
+}
+
+/* Minimizes f with Brent's method, as implemented in GSL, given x in (lower,upper) with
+   f(x) smaller than f(lower) and f(upper). Returns the minimum and stores the minimizer
+   in x. */
+template<class F>
+double brentMinimize(const F &f, double lower, double &x, double upper, double fx, double epsabs, double epsrel, unsigned maxIter)
+{
+    const double golden = 0.3819660;
+    const double sqrteps = 1.4901161193847656E-08;
+    double      v = lower + golden*(upper-lower);
+    double      w = v;
+    double      fv = f(v);
+    double      fw = fv;
+    double      d = 0, e = 0;
+    double      z, tolerance, midpoint, p, q, r, u, fu, t;
+    unsigned    iter;
+
+    for(iter=0; iter<maxIter && !minimizeConverged(lower, upper, epsabs, epsrel); iter++)
+    {
+        z = x;
+        t = d; d = e; e = t;
+        tolerance = sqrteps*std::fabs(z);
+        midpoint  = 0.5*(lower+upper);
+        p = q = r = 0;
+
+        if(std::fabs(e)>tolerance)
+        {
+            r = (z-w)*(fx-fv);
+            q = (z-v)*(fx-fw);
+            p = (z-v)*q-(z-w)*r;
+            q = 2*(q-r);
+            if(q>0) p = -p; else q = -q;
+            r = e;
+            e = d;
+        }
+
+        if(std::fabs(p)<std::fabs(0.5*q*r) && p<q*(z-lower) && p<q*(upper-z))
+        {
+            d = p/q;
+            u = z+d;
+            if((u-lower)<2*tolerance || (upper-u)<2*tolerance) d = z<midpoint ? tolerance : -tolerance;
+        }
+        else
+        {
+            e = z<midpoint ? upper-z : -(z-lower);
+            d = golden*e;
+        }
+
+        u  = std::fabs(d)>=tolerance ? z+d : z+(d>0 ? tolerance : -tolerance);
+        fu = f(u);
+
+        if(fu<=fx)
+        {
+            if(u<z) upper = z; else lower = z;
+            v = w; fv = fw;
+            w = z; fw = fx;
+            x = u; fx = fu;
+        }
+        else
+        {
+            if(u<z) lower = u; else upper = u;
+            if(fu<=fw || w==z) { v = w; fv = fw; w = u; fw = fu; }
+            else if(fu<=fv || v==z || v==w) { v = u; fv = fu; }
+        }
+    }
+    return fx;
+}
+
+/* Minimizes f over theta as done by llrMinimize (see llrTable.h): the interval [-0.5,1.5]
+   is expanded by doubling its ends until it brackets a minimum, which is then refined with
+   Brent's method. Returns the minimum and stores the minimizer in thmin, if not NULL. */
+template<class F>
+double minimizeTheta(const F &f, double *thmin)
+{
+    double  thl = -0.5, thm = 0.5, thr = 1.5;
+    double  dil = f(thl), dim = f(thm), dir = f(thr);
+    double  dimin;
+    int     iter = 0;
+    int     max_iter = 1000;
+
+    /* Looking for lower limit of minimization interval */
+    while(dil<dim && iter++<max_iter)
+    {
+        dir = dim; dim = dil;
+        thr = thm; thm = thl;
+        dil = f(thl *= 2);
+    }
+
+    /* Looking for upper limit of minimization interval */
+    while(dir<dim && iter++<max_iter)
+    {
+        dil = dim; dim = dir;
+        thl = thm; thm = thr;
+        dir = f(thr *= 2);
+    }
+
+    /* Flat or monotonic within the allowed number of expansions */
+    if(!(dim<dil && dim<dir))
+    {
+        if(thmin!=NULL) *thmin = dil<dir ? (dil<dim ? thl : thm) : (dir<dim ? thr : thm);
+        return std::min(dim, std::min(dil, dir));
+    }
+
+    dimin = brentMinimize(f, thl, thm, thr, dim, 1E-6, 1E-3, max_iter);
+    if(thmin!=NULL) *thmin = thm;
+    return dimin;
+}
+
+#endif